@@ -22,7 +22,7 @@ def print_call_settings(nick, cmd, stdin, time_limit, memory_limit):
     logging.info("{} command line string: {}".format(nick, " ".join(escaped_cmd)))
 
 
-def _get_preexec_function(time_limit, memory_limit):
+def _get_preexec_function(time_limit, memory_limit, raisable_memory_limit):
     def set_limits():
         def _try_or_exit(function, description):
             def fail(exception, exitcode):
@@ -38,7 +38,9 @@ def _get_preexec_function(time_limit, memory_limit):
                 fail(err, returncodes.DRIVER_INPUT_ERROR)
 
         _try_or_exit(lambda: limits.set_time_limit(time_limit), "Setting time limit")
-        _try_or_exit(lambda: limits.set_memory_limit(memory_limit), "Setting memory limit")
+        _try_or_exit(
+            lambda: limits.set_memory_limit(memory_limit, raisable_memory_limit),
+            "Setting memory limit")
 
     if time_limit is None and memory_limit is None:
         return None
@@ -46,10 +48,12 @@ def _get_preexec_function(time_limit, memory_limit):
         return set_limits
 
 
-def check_call(nick, cmd, stdin=None, time_limit=None, memory_limit=None):
+def check_call(nick, cmd, stdin=None, time_limit=None, memory_limit=None,
+               raisable_memory_limit=False):
     print_call_settings(nick, cmd, stdin, time_limit, memory_limit)
 
-    kwargs = {"preexec_fn": _get_preexec_function(time_limit, memory_limit)}
+    kwargs = {"preexec_fn": _get_preexec_function(
+        time_limit, memory_limit, raisable_memory_limit)}
 
     sys.stdout.flush()
     if stdin:
@@ -62,7 +66,7 @@ def check_call(nick, cmd, stdin=None, time_limit=None, memory_limit=None):
 def get_error_output_and_returncode(nick, cmd, time_limit=None, memory_limit=None):
     print_call_settings(nick, cmd, None, time_limit, memory_limit)
 
-    preexec_fn = _get_preexec_function(time_limit, memory_limit)
+    preexec_fn = _get_preexec_function(time_limit, memory_limit, False)
 
     sys.stdout.flush()
     p = subprocess.Popen(cmd, preexec_fn=preexec_fn, stderr=subprocess.PIPE)
@@ -48,13 +48,19 @@ def set_time_limit(time_limit):
         resource.setrlimit(resource.RLIMIT_CPU, (time_limit, time_limit))
 
 
-def set_memory_limit(memory):
-    """*memory* must be given in bytes or None."""
+def set_memory_limit(memory, raisable=False):
+    """*memory* must be given in bytes or None. If *raisable* is True, we
+    only set the soft limit, so that the process can raise it, e.g., for
+    memory-mapped spill files."""
     if memory is None:
         return
     if not can_set_memory_limit():
         raise NotImplementedError(CANNOT_LIMIT_MEMORY_MSG)
-    resource.setrlimit(resource.RLIMIT_AS, (memory, memory))
+    if raisable:
+        _, hard_limit = resource.getrlimit(resource.RLIMIT_AS)
+        resource.setrlimit(resource.RLIMIT_AS, (memory, hard_limit))
+    else:
+        resource.setrlimit(resource.RLIMIT_AS, (memory, memory))
 
 
 def convert_to_mb(num_bytes):
@@ -70,7 +70,8 @@ def run_search(executable, args, sas_file, plan_manager, time, memory):
     try:
         exitcode = call.check_call(
             "search", complete_args, stdin=sas_file,
-            time_limit=time, memory_limit=memory)
+            time_limit=time, memory_limit=memory,
+            raisable_memory_limit="--spill-directory" in args)
     except subprocess.CalledProcessError as err:
         exitcode = err.returncode
     print("exitcode: %d" % exitcode)
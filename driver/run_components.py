@@ -125,7 +125,9 @@ def run_search(args):
                 [executable] + args.search_options,
                 stdin=args.search_input,
                 time_limit=time_limit,
-                memory_limit=memory_limit)
+                memory_limit=memory_limit,
+                # The search exempts spill files from the memory limit.
+                raisable_memory_limit="--spill-directory" in args.search_options)
         except subprocess.CalledProcessError as err:
             # TODO: if we ever add support for SEARCH_PLAN_FOUND_AND_* directly
             # in the planner, this assertion no longer holds. Furthermore, we
@@ -1,9 +1,22 @@
+import tempfile
+
+
 def configs_optimal_core():
     return {
         # A*
         "astar_blind": [
             "--search",
             "astar(blind)"],
+        "astar_blind_tight": [
+            "--search",
+            "astar(blind(), state_compression=TIGHT)"],
+        "astar_blind_dictionary": [
+            "--search",
+            "astar(blind(), state_compression=DICTIONARY)"],
+        "astar_blind_spill": [
+            "--spill-directory", tempfile.gettempdir(),
+            "--search",
+            "astar(blind())"],
         "astar_h2": [
             "--search",
             "astar(hm(2))"],
@@ -132,6 +145,21 @@ def configs_optimal_extended():
         "pdb": [
             "--search",
             "astar(pdb())"],
+        "astar_lmcut_dks_exact": [
+            "--symmetries",
+            "sym=structural_symmetries(search_symmetries=dks,"
+            "canonicalization=exact)",
+            "--search",
+            "astar(lmcut(), symmetries=sym)"],
+        "astar_lmcut_oss_exact": [
+            "--symmetries",
+            "sym=structural_symmetries(search_symmetries=oss,"
+            "canonicalization=exact)",
+            "--search",
+            "astar(lmcut(), symmetries=sym)"],
+        "hdastar_lmcut": [
+            "--search",
+            "hdastar(lmcut(), num_threads=2)"],
     }
 
 
@@ -201,6 +229,25 @@ def configs_optimal_lp(lp_solver="CPLEX"):
     return {
         "divpot": ["--search", f"astar(diverse_potentials(lpsolver={lp_solver}))"],
         "seq+lmcut": ["--search", f"astar(operatorcounting([state_equation_constraints(), lmcut_constraints()], lpsolver={lp_solver}))"],
+        "seq-folded": ["--symmetries", "sym=structural_symmetries(search_symmetries=none)", "--search", f"astar(operatorcounting([state_equation_constraints()], lpsolver={lp_solver}, symmetries=sym))"],
+        "initpot-folded": ["--symmetries", "sym=structural_symmetries(search_symmetries=none)", "--search", f"astar(initial_state_potential(lpsolver={lp_solver}, symmetries=sym))"],
+    }
+
+
+def configs_lp_folding(lp_solver="CPLEX"):
+    """
+    Pairs of unfolded and folded configurations that must have the same
+    initial heuristic value: the symmetries stabilize the initial state, so
+    the objectives and constraint bounds are invariant under them.
+    """
+    symmetries = "sym=structural_symmetries(search_symmetries=none, stabilize_initial_state=true)"
+    return {
+        "seq": (
+            ["--search", f"astar(operatorcounting([state_equation_constraints()], lpsolver={lp_solver}))"],
+            ["--symmetries", symmetries, "--search", f"astar(operatorcounting([state_equation_constraints()], lpsolver={lp_solver}, symmetries=sym))"]),
+        "initpot": (
+            ["--search", f"astar(initial_state_potential(lpsolver={lp_solver}))"],
+            ["--symmetries", symmetries, "--search", f"astar(initial_state_potential(lpsolver={lp_solver}, symmetries=sym))"]),
     }
 
 
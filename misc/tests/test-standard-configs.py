@@ -1,5 +1,6 @@
 import os
 import pipes
+import re
 import subprocess
 import sys
 
@@ -14,6 +15,8 @@ FAST_DOWNWARD = os.path.join(REPO, "fast-downward.py")
 SAS_FILE = os.path.join(REPO, "test.sas")
 PLAN_FILE = os.path.join(REPO, "test.plan")
 TASK = os.path.join(BENCHMARKS_DIR, "miconic/s1-0.pddl")
+SYMMETRIC_SAS_FILE = os.path.join(REPO, "test-symmetric.sas")
+SYMMETRIC_TASK = os.path.join(BENCHMARKS_DIR, "gripper/prob01.pddl")
 
 CONFIGS_NOLP = {}
 CONFIGS_NOLP.update(configs.default_configs_optimal(core=True, extended=True))
@@ -38,18 +41,29 @@ def run_plan_script(task, config, debug):
     subprocess.check_call(cmd, cwd=REPO)
 
 
-def translate(task):
+def get_initial_heuristic_value(task, config):
+    cmd = [sys.executable, FAST_DOWNWARD, "--plan-file", PLAN_FILE, task] + config
+    print("\nRun: {}:".format(escape_list(cmd)))
+    output = subprocess.check_output(cmd, cwd=REPO, universal_newlines=True)
+    match = re.search(r"Initial heuristic value for .*: (\d+)$", output, re.M)
+    assert match, output
+    return int(match.group(1))
+
+
+def translate(task, sas_file=SAS_FILE):
     subprocess.check_call([
-        sys.executable, FAST_DOWNWARD, "--sas-file", SAS_FILE, "--translate", task], cwd=REPO)
+        sys.executable, FAST_DOWNWARD, "--sas-file", sas_file, "--translate", task], cwd=REPO)
 
 
 def cleanup():
     os.remove(SAS_FILE)
+    os.remove(SYMMETRIC_SAS_FILE)
     os.remove(PLAN_FILE)
 
 
 def setup_module(module):
     translate(TASK)
+    translate(SYMMETRIC_TASK, SYMMETRIC_SAS_FILE)
 
 
 @pytest.mark.parametrize("config", sorted(CONFIGS_NOLP.values()))
@@ -70,5 +84,13 @@ def test_configs_soplex(config, debug):
     run_plan_script(SAS_FILE, config, debug)
 
 
+@pytest.mark.parametrize("lp_solver", ["CPLEX", "SOPLEX"])
+@pytest.mark.parametrize("name", sorted(configs.configs_lp_folding()))
+def test_lp_folding(lp_solver, name):
+    unfolded_config, folded_config = configs.configs_lp_folding(lp_solver)[name]
+    assert (get_initial_heuristic_value(SYMMETRIC_SAS_FILE, folded_config) ==
+            get_initial_heuristic_value(SYMMETRIC_SAS_FILE, unfolded_config))
+
+
 def teardown_module(module):
     cleanup()
@@ -74,6 +74,7 @@ fast_downward_plugin(
         search_progress
         search_space
         search_statistics
+        state_codec
         state_id
         state_registry
         task_id
@@ -118,6 +119,7 @@ fast_downward_plugin(
         utils/memory
         utils/rng
         utils/rng_options
+        utils/spillable_memory
         utils/strings
         utils/system
         utils/system_unix
@@ -311,6 +313,14 @@ fast_downward_plugin(
     DEPENDS COMBINING_EVALUATOR EVALUATORS_PLUGIN_GROUP
 )
 
+fast_downward_plugin(
+    NAME SYMMETRIC_CACHE_EVALUATOR
+    HELP "The symmetric cache evaluator"
+    SOURCES
+        evaluators/symmetric_cache_evaluator
+    DEPENDS EVALUATORS_PLUGIN_GROUP STRUCTURAL_SYMMETRIES
+)
+
 fast_downward_plugin(
     NAME NULL_PRUNING_METHOD
     HELP "Pruning method that does nothing"
@@ -450,6 +460,14 @@ fast_downward_plugin(
     DEPENDS G_EVALUATOR ORDERED_SET PREF_EVALUATOR SEARCH_COMMON SUCCESSOR_GENERATOR
 )
 
+fast_downward_plugin(
+    NAME HDA_STAR_SEARCH
+    HELP "Hash-distributed A* search with one thread per shard"
+    SOURCES
+        search_engines/hda_star_search
+    DEPENDS SUCCESSOR_GENERATOR
+)
+
 fast_downward_plugin(
     NAME ITERATED_SEARCH
     HELP "Iterated search algorithm"
@@ -470,6 +488,7 @@ fast_downward_plugin(
     NAME LP_SOLVER
     HELP "Interface to an LP solver"
     SOURCES
+        lp/lp_folding
         lp/lp_internals
         lp/lp_solver
     DEPENDS NAMED_VECTOR
@@ -651,7 +670,7 @@ fast_downward_plugin(
         cegar/types
         cegar/utils
         cegar/utils_landmarks
-    DEPENDS ADDITIVE_HEURISTIC DYNAMIC_BITSET EXTRA_TASKS LANDMARKS PRIORITY_QUEUES TASK_PROPERTIES
+    DEPENDS ADDITIVE_HEURISTIC DYNAMIC_BITSET EXTRA_TASKS LANDMARKS PRIORITY_QUEUES STRUCTURAL_SYMMETRIES TASK_PROPERTIES
 )
 
 fast_downward_plugin(
@@ -730,7 +749,7 @@ fast_downward_plugin(
         operator_counting/operator_counting_heuristic
         operator_counting/pho_constraints
         operator_counting/state_equation_constraints
-    DEPENDS LP_SOLVER LANDMARK_CUT_HEURISTIC PDBS TASK_PROPERTIES
+    DEPENDS LP_SOLVER LANDMARK_CUT_HEURISTIC PDBS STRUCTURAL_SYMMETRIES TASK_PROPERTIES
 )
 
 fast_downward_plugin(
@@ -765,12 +784,14 @@ fast_downward_plugin(
         pdbs/pdb_heuristic
         pdbs/plugin_group
         pdbs/random_pattern
+        pdbs/symmetric_lookups
+        pdbs/symmetric_pdb_factory
         pdbs/types
         pdbs/utils
         pdbs/validation
         pdbs/zero_one_pdbs
         pdbs/zero_one_pdbs_heuristic
-    DEPENDS CAUSAL_GRAPH MAX_CLIQUES PRIORITY_QUEUES SAMPLING SUCCESSOR_GENERATOR TASK_PROPERTIES VARIABLE_ORDER_FINDER
+    DEPENDS CAUSAL_GRAPH MAX_CLIQUES PRIORITY_QUEUES SAMPLING STRUCTURAL_SYMMETRIES SUCCESSOR_GENERATOR TASK_PROPERTIES VARIABLE_ORDER_FINDER
 )
 
 fast_downward_plugin(
@@ -786,7 +807,7 @@ fast_downward_plugin(
         potentials/sample_based_potential_heuristics
         potentials/single_potential_heuristics
         potentials/util
-    DEPENDS LP_SOLVER SAMPLING SUCCESSOR_GENERATOR TASK_PROPERTIES
+    DEPENDS LP_SOLVER SAMPLING STRUCTURAL_SYMMETRIES SUCCESSOR_GENERATOR TASK_PROPERTIES
 )
 
 fast_downward_plugin(
@@ -820,10 +841,14 @@ fast_downward_plugin(
     NAME STRUCTURAL_SYMMETRIES
     HELP "Plugin containing the code for computing structural symmetries"
     SOURCES
+        structural_symmetries/automorphism_backend.cc
+        structural_symmetries/generator_cache.cc
         structural_symmetries/graph_creator.cc
         structural_symmetries/group.cc
+        structural_symmetries/operator_mapper.cc
         structural_symmetries/permutation.cc
-    DEPENDS BLISS
+        structural_symmetries/stabilizer_chain.cc
+    DEPENDS BLISS TASK_PROPERTIES
 )
 
 fast_downward_add_plugin_sources(PLANNER_SOURCES)
@@ -42,6 +42,16 @@ public:
     int get(const Bin *buffer, int var) const;
     void set(Bin *buffer, int var, int value) const;
 
+    /*
+      Access to the bin layout of a variable, for code that reads and writes
+      the same variables of many buffers and wants to precompute where they
+      are stored. The value of var is
+      (buffer[get_bin_index(var)] & get_read_mask(var)) >> get_shift(var).
+    */
+    int get_bin_index(int var) const;
+    int get_shift(int var) const;
+    Bin get_read_mask(int var) const;
+
     int get_num_bins() const {return num_bins;}
 };
 }
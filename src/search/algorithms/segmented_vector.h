@@ -1,6 +1,8 @@
 #ifndef ALGORITHMS_SEGMENTED_VECTOR_H
 #define ALGORITHMS_SEGMENTED_VECTOR_H
 
+#include "../utils/spillable_memory.h"
+
 #include <algorithm>
 #include <cassert>
 #include <iostream>
@@ -35,6 +37,11 @@
   storing many fixed-size arrays. It's essentially a variant of SegmentedVector
   where the size of the stored data is only known at runtime, not at compile
   time. Note that we do not support 0-length arrays (checked with an assertion).
+
+  SpillableSegmentedVector and SpillableSegmentedArrayVector allocate
+  their segments with SpillableAllocator, so they can be spilled to disk
+  (see utils/spillable_memory.h). They are used for the data stored for
+  every state.
 */
 
 // TODO: Get rid of the code duplication here. How to do it without
@@ -266,6 +273,14 @@ public:
         }
     }
 };
+
+template<class Entry>
+using SpillableSegmentedVector =
+    SegmentedVector<Entry, utils::SpillableAllocator<Entry>>;
+
+template<class Element>
+using SpillableSegmentedArrayVector =
+    SegmentedArrayVector<Element, utils::SpillableAllocator<Element>>;
 }
 
 #endif
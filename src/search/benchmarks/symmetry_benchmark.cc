@@ -0,0 +1,317 @@
+/*
+  Microbenchmarks for the hot paths of search with structural symmetries.
+
+  Reads a task in SAS+ format from stdin, computes the symmetry group
+  (or loads its generators with generator_cache_dir), samples states with
+  random walks and measures the time per operation for canonicalization,
+  constructing and composing permutations, permuting states and
+  inserting successors into state registries with and without DKS.
+
+  Usage:
+    symmetry-benchmark [--symmetries CONFIG] [--samples N]
+                       [--repetitions N] [--random-seed N]
+                       [--output FILE] < output.sas
+*/
+
+#include "../command_line.h"
+#include "../option_parser.h"
+#include "../state_registry.h"
+#include "../task_proxy.h"
+
+#include "../options/registries.h"
+#include "../structural_symmetries/group.h"
+#include "../structural_symmetries/permutation.h"
+#include "../task_utils/sampling.h"
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../tasks/root_task.h"
+#include "../utils/logging.h"
+#include "../utils/rng.h"
+#include "../utils/system.h"
+#include "../utils/timer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using utils::ExitCode;
+
+struct BenchmarkOptions {
+    string symmetries = "structural_symmetries(search_symmetries=dks)";
+    int num_samples = 1000;
+    int num_repetitions = 10;
+    int random_seed = 2023;
+    string output_file = "symmetry_benchmark.json";
+};
+
+struct BenchmarkResult {
+    string name;
+    long long num_operations;
+    double time;
+
+    double get_nanoseconds_per_operation() const {
+        return num_operations == 0 ? 0 : time * 1e9 / num_operations;
+    }
+};
+
+static int parse_int_arg(const string &name, const string &value) {
+    try {
+        return stoi(value);
+    } catch (invalid_argument &) {
+        throw ArgError("argument for " + name + " must be an integer");
+    } catch (out_of_range &) {
+        throw ArgError("argument for " + name + " is out of range");
+    }
+}
+
+static BenchmarkOptions parse_benchmark_options(int argc, const char **argv) {
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i == argc - 1) {
+            throw ArgError("missing argument after " + arg);
+        }
+        string value = argv[++i];
+        if (arg == "--symmetries") {
+            options.symmetries = value;
+        } else if (arg == "--samples") {
+            options.num_samples = parse_int_arg(arg, value);
+        } else if (arg == "--repetitions") {
+            options.num_repetitions = parse_int_arg(arg, value);
+        } else if (arg == "--random-seed") {
+            options.random_seed = parse_int_arg(arg, value);
+        } else if (arg == "--output") {
+            options.output_file = value;
+        } else {
+            throw ArgError("unknown option " + arg);
+        }
+    }
+    if (options.num_samples < 1 || options.num_repetitions < 1) {
+        throw ArgError("number of samples and repetitions must be positive");
+    }
+    return options;
+}
+
+static shared_ptr<Group> parse_group(const string &config) {
+    options::Registry registry(*options::RawRegistry::instance());
+    options::Predefinitions predefinitions;
+    OptionParser parser(config, registry, predefinitions, false);
+    return parser.start_parsing<shared_ptr<Group>>();
+}
+
+/*
+  Run the given function num_repetitions times. The function performs
+  the benchmarked operations and returns how many it performed.
+*/
+template<typename Function>
+static BenchmarkResult run_benchmark(
+    const string &name, int num_repetitions, Function run_once) {
+    BenchmarkResult result {name, 0, 0};
+    utils::Timer timer;
+    for (int i = 0; i < num_repetitions; ++i) {
+        result.num_operations += run_once();
+    }
+    result.time = timer();
+    utils::g_log << name << ": " << result.num_operations << " operations, "
+                 << result.get_nanoseconds_per_operation() << " ns/op"
+                 << endl;
+    return result;
+}
+
+static void write_results(
+    const BenchmarkOptions &options, const TaskProxy &task_proxy,
+    const Group &group, const vector<BenchmarkResult> &results) {
+    ofstream file(options.output_file);
+    if (!file) {
+        cerr << "Could not open benchmark output file "
+             << options.output_file << endl;
+        utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    file << "{\"variables\": " << task_proxy.get_variables().size()
+         << ", \"operators\": " << task_proxy.get_operators().size()
+         << ", \"generators\": " << group.get_num_generators()
+         << ", \"samples\": " << options.num_samples
+         << ", \"repetitions\": " << options.num_repetitions
+         << ", \"benchmarks\": {";
+    string separator;
+    for (const BenchmarkResult &result : results) {
+        file << separator << "\"" << result.name << "\": {\"operations\": "
+             << result.num_operations << ", \"time\": " << result.time
+             << ", \"ns_per_op\": " << result.get_nanoseconds_per_operation()
+             << "}";
+        separator = ", ";
+    }
+    file << "}}" << endl;
+    utils::g_log << "Benchmark results written to " << options.output_file
+                 << endl;
+}
+
+int main(int argc, const char **argv) {
+    utils::register_event_handlers();
+
+    BenchmarkOptions options;
+    shared_ptr<Group> group;
+    try {
+        options = parse_benchmark_options(argc, argv);
+        utils::g_log << "reading input..." << endl;
+        tasks::read_root_task(cin);
+        utils::g_log << "done reading input!" << endl;
+        group = parse_group(options.symmetries);
+    } catch (const ArgError &error) {
+        error.print();
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    } catch (const OptionParserError &error) {
+        error.print();
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    } catch (const ParseError &error) {
+        error.print();
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+
+    TaskProxy task_proxy(*tasks::g_root_task);
+    group->compute_symmetries(task_proxy);
+    if (!group->has_symmetries()) {
+        utils::g_log << "No symmetries found, nothing to benchmark." << endl;
+        utils::exit_with(ExitCode::SUCCESS);
+    }
+
+    /*
+      Sample states with random walks whose length is estimated from the
+      number of unsatisfied goals. The samples are unregistered, so we
+      register them with the identity permutation to get packed states.
+    */
+    utils::RandomNumberGenerator rng(options.random_seed);
+    sampling::RandomWalkSampler sampler(task_proxy, rng);
+    State initial_state = task_proxy.get_initial_state();
+    int num_unsatisfied_goals = 0;
+    for (FactProxy goal : task_proxy.get_goals()) {
+        if (initial_state[goal.get_variable()] != goal) {
+            ++num_unsatisfied_goals;
+        }
+    }
+    int init_h = static_cast<int>(
+        num_unsatisfied_goals *
+        task_properties::get_average_operator_cost(task_proxy) + 0.5);
+    StateRegistry sample_registry(task_proxy);
+    Permutation identity(*group);
+    vector<State> samples;
+    samples.reserve(options.num_samples);
+    for (int i = 0; i < options.num_samples; ++i) {
+        samples.push_back(sample_registry.permute_state(
+                              sampler.sample_state(init_h), identity));
+    }
+
+    // Choose a random applicable operator for each sample, if any.
+    successor_generator::SuccessorGenerator &successor_generator =
+        successor_generator::g_successor_generators[task_proxy];
+    OperatorsProxy operators = task_proxy.get_operators();
+    vector<pair<State, OperatorProxy>> transitions;
+    vector<OperatorID> applicable_operators;
+    for (const State &sample : samples) {
+        applicable_operators.clear();
+        successor_generator.generate_applicable_ops(sample, applicable_operators);
+        if (!applicable_operators.empty()) {
+            transitions.emplace_back(
+                sample, operators[*rng.choose(applicable_operators)]);
+        }
+    }
+
+    int num_elements = min(options.num_samples, 100);
+    vector<RawPermutation> elements = group->compute_group_elements(num_elements);
+    vector<Permutation> element_permutations;
+    for (const RawPermutation &element : elements) {
+        element_permutations.emplace_back(*group, element);
+    }
+    utils::g_log << "Sampled " << samples.size() << " states and "
+                 << elements.size() << " group elements" << endl;
+
+    int num_bins = sample_registry.get_state_packer().get_num_bins();
+    vector<PackedStateBin> buffer(num_bins);
+    // Results are accumulated here so the compiler keeps the computations.
+    long long checksum = 0;
+    vector<BenchmarkResult> results;
+
+    results.push_back(run_benchmark(
+        "canonicalization", options.num_repetitions, [&]() {
+            for (const State &sample : samples) {
+                copy(sample.get_buffer(), sample.get_buffer() + num_bins,
+                     buffer.begin());
+                checksum += group->compute_canonical_representative(
+                    buffer.data());
+            }
+            return samples.size();
+        }));
+
+    results.push_back(run_benchmark(
+        "canonicalization_with_trace", options.num_repetitions, [&]() {
+            for (const State &sample : samples) {
+                vector<int> values = sample.get_unpacked_values();
+                checksum += group->compute_canonical_representative_and_trace(
+                    values).size();
+            }
+            return samples.size();
+        }));
+
+    results.push_back(run_benchmark(
+        "permutation_construction", options.num_repetitions, [&]() {
+            for (const RawPermutation &element : elements) {
+                Permutation permutation(*group, element);
+                checksum += permutation.get_affected_vars().size();
+            }
+            return elements.size();
+        }));
+
+    results.push_back(run_benchmark(
+        "compose_permutations", options.num_repetitions, [&]() {
+            RawPermutation product = group->new_identity_raw_permutation();
+            for (const RawPermutation &element : elements) {
+                product = group->compose_permutations(product, element);
+            }
+            checksum += product[0];
+            return elements.size();
+        }));
+
+    results.push_back(run_benchmark(
+        "permute_state", options.num_repetitions, [&]() {
+            StateRegistry registry(task_proxy);
+            for (const State &sample : samples) {
+                for (const Permutation &permutation : element_permutations) {
+                    registry.permute_state(sample, permutation);
+                }
+            }
+            checksum += registry.size();
+            return samples.size() * element_permutations.size();
+        }));
+
+    results.push_back(run_benchmark(
+        "registry_insertion", options.num_repetitions, [&]() {
+            StateRegistry registry(task_proxy);
+            for (const auto &transition : transitions) {
+                registry.get_successor_state(
+                    transition.first, transition.second);
+            }
+            checksum += registry.size();
+            return transitions.size();
+        }));
+
+    results.push_back(run_benchmark(
+        "dks_registry_insertion", options.num_repetitions, [&]() {
+            StateRegistry registry(task_proxy);
+            registry.set_group(group);
+            for (const auto &transition : transitions) {
+                registry.get_successor_state(
+                    transition.first, transition.second);
+            }
+            checksum += registry.size();
+            return transitions.size();
+        }));
+
+    utils::g_log << "Checksum: " << checksum << endl;
+    write_results(options, task_proxy, *group, results);
+    utils::g_timer.stop();
+    utils::g_log << "Total time: " << utils::g_timer << endl;
+    return 0;
+}
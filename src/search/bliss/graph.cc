@@ -1987,6 +1987,24 @@ Digraph::add_vertex(const unsigned int color)
 }
 
 
+void
+Digraph::reserve_vertices(const unsigned int nof_vertices)
+{
+  vertices.reserve(nof_vertices);
+}
+
+
+void
+Digraph::reserve_edges(const unsigned int vertex,
+                       const unsigned int nof_edges_out,
+                       const unsigned int nof_edges_in)
+{
+  assert(vertex < get_nof_vertices());
+  vertices[vertex].edges_out.reserve(nof_edges_out);
+  vertices[vertex].edges_in.reserve(nof_edges_in);
+}
+
+
 void
 Digraph::add_edge(const unsigned int vertex1, const unsigned int vertex2)
 {
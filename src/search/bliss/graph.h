@@ -935,6 +935,33 @@ public:
    */
   unsigned int add_vertex(const unsigned int color = 0);
 
+  /**
+   * Return the color of the vertex \a v.
+   */
+  unsigned int get_color(const unsigned int v) const {return vertices[v].color; }
+
+  /**
+   * Return the targets of the edges leaving the vertex \a v
+   * (possibly including duplicates).
+   */
+  const std::vector<unsigned int>& get_edges_out(const unsigned int v) const {
+    return vertices[v].edges_out;
+  }
+
+  /**
+   * Reserve memory for \a nof_vertices vertices in total, so that adding
+   * vertices does not reallocate (and copy) the adjacency lists.
+   */
+  void reserve_vertices(const unsigned int nof_vertices);
+
+  /**
+   * Reserve memory for the given number of outgoing and incoming edges of
+   * the vertex \a v.
+   */
+  void reserve_edges(const unsigned int v,
+                     const unsigned int nof_edges_out,
+                     const unsigned int nof_edges_in);
+
   /**
    * Add an edge from vertix \a v1 to vertex \a v2.
    * Duplicate edges are ignored but try to avoid introducing
@@ -56,6 +56,11 @@ unique_ptr<RefinementHierarchy> Abstraction::extract_refinement_hierarchy() {
     return move(refinement_hierarchy);
 }
 
+unique_ptr<TransitionSystem> Abstraction::extract_transition_system() {
+    assert(transition_system);
+    return move(transition_system);
+}
+
 void Abstraction::mark_all_states_as_goals() {
     goals.clear();
     for (auto &state : states) {
@@ -26,7 +26,7 @@ class TransitionSystem;
   RefinementHierarchy.
 */
 class Abstraction {
-    const std::unique_ptr<TransitionSystem> transition_system;
+    std::unique_ptr<TransitionSystem> transition_system;
     const State concrete_initial_state;
     const std::vector<FactPair> goal_facts;
 
@@ -57,6 +57,7 @@ public:
     const AbstractState &get_state(int state_id) const;
     const TransitionSystem &get_transition_system() const;
     std::unique_ptr<RefinementHierarchy> extract_refinement_hierarchy();
+    std::unique_ptr<TransitionSystem> extract_transition_system();
 
     /* Needed for CEGAR::separate_facts_unreachable_before_goal(). */
     void mark_all_states_as_goals();
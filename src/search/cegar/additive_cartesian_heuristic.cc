@@ -8,6 +8,8 @@
 #include "../option_parser.h"
 #include "../plugin.h"
 
+#include "../structural_symmetries/group.h"
+
 #include "../utils/logging.h"
 #include "../utils/markup.h"
 #include "../utils/rng.h"
@@ -35,7 +37,8 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
         opts.get<bool>("use_general_costs"),
         opts.get<PickSplit>("pick"),
         *rng,
-        log);
+        log,
+        opts.get<shared_ptr<Group>>("symmetries", nullptr));
     return cost_saturation.generate_heuristic_functions(
         opts.get<shared_ptr<AbstractTask>>("transform"));
 }
@@ -137,6 +140,14 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "use_general_costs",
         "allow negative costs in cost partitioning",
         "true");
+    parser.add_option<shared_ptr<Group>>(
+        "symmetries",
+        "symmetries object to compute structural symmetries; if given, "
+        "subtasks whose goal fact is symmetric to the goal fact of an "
+        "already refined subtask use the image of its abstraction instead "
+        "of being refined. The symmetries must stabilize the initial state "
+        "and only apply to subtasks without domain abstraction",
+        OptionParser::NONE);
     Heuristic::add_options_to_parser(parser);
     utils::add_rng_options(parser);
 
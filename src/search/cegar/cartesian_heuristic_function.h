@@ -26,6 +26,10 @@ public:
     CartesianHeuristicFunction(CartesianHeuristicFunction &&) = default;
 
     int get_value(const State &state) const;
+
+    const RefinementHierarchy &get_refinement_hierarchy() const {
+        return *refinement_hierarchy;
+    }
 };
 }
 
@@ -9,14 +9,21 @@
 #include "transition_system.h"
 #include "utils.h"
 
+#include "../structural_symmetries/group.h"
+#include "../structural_symmetries/operator_mapper.h"
+#include "../structural_symmetries/permutation.h"
 #include "../task_utils/task_properties.h"
 #include "../tasks/modified_operator_costs_task.h"
+#include "../tasks/root_task.h"
 #include "../utils/countdown_timer.h"
 #include "../utils/logging.h"
 #include "../utils/memory.h"
+#include "../utils/system.h"
 
 #include <algorithm>
 #include <cassert>
+#include <iostream>
+#include <numeric>
 
 using namespace std;
 
@@ -89,7 +96,8 @@ CostSaturation::CostSaturation(
     bool use_general_costs,
     PickSplit pick_split,
     utils::RandomNumberGenerator &rng,
-    utils::LogProxy &log)
+    utils::LogProxy &log,
+    const shared_ptr<Group> &symmetries)
     : subtask_generators(subtask_generators),
       max_states(max_states),
       max_non_looping_transitions(max_non_looping_transitions),
@@ -98,9 +106,14 @@ CostSaturation::CostSaturation(
       pick_split(pick_split),
       rng(rng),
       log(log),
+      symmetries(symmetries),
       num_abstractions(0),
       num_states(0),
-      num_non_looping_transitions(0) {
+      num_non_looping_transitions(0),
+      num_derived_abstractions(0) {
+}
+
+CostSaturation::~CostSaturation() {
 }
 
 vector<CartesianHeuristicFunction> CostSaturation::generate_heuristic_functions(
@@ -116,6 +129,7 @@ vector<CartesianHeuristicFunction> CostSaturation::generate_heuristic_functions(
     task_properties::verify_no_conditional_effects(task_proxy);
 
     reset(task_proxy);
+    initialize_symmetries(task_proxy);
 
     State initial_state = TaskProxy(*task).get_initial_state();
 
@@ -138,6 +152,9 @@ vector<CartesianHeuristicFunction> CostSaturation::generate_heuristic_functions(
     if (utils::extra_memory_padding_is_reserved())
         utils::release_extra_memory_padding();
     print_statistics(timer.get_elapsed_time());
+    symmetric_abstractions.clear();
+    orbit_entries.clear();
+    orbit_entry_by_goal.clear();
 
     vector<CartesianHeuristicFunction> functions;
     swap(heuristic_functions, functions);
@@ -151,6 +168,216 @@ void CostSaturation::reset(const TaskProxy &task_proxy) {
     num_states = 0;
 }
 
+void CostSaturation::initialize_symmetries(const TaskProxy &task_proxy) {
+    if (!symmetries) {
+        return;
+    }
+    if (!symmetries->is_stabilizing_initial_state()) {
+        /*
+          For subtasks with a single goal, CEGAR treats all states with
+          facts that are unreachable from the initial state before the goal
+          as goal states. This is only preserved by symmetries that
+          stabilize the initial state.
+        */
+        cerr << "Symmetric Cartesian abstractions require symmetries that "
+             << "stabilize the initial state." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+    if (!symmetries->is_initialized()) {
+        log << "Initializing symmetries (symmetric Cartesian abstractions)"
+            << endl;
+        symmetries->compute_symmetries(TaskProxy(*tasks::g_root_task));
+    }
+    domain_sizes = get_domain_sizes(task_proxy);
+    if (!symmetries->has_symmetries()) {
+        return;
+    }
+    if (symmetries->get_permutation_num_variables() !=
+        static_cast<int>(domain_sizes.size())) {
+        cerr << "Symmetric Cartesian abstractions require the variables of "
+             << "the root task." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+    OperatorMapper operator_mapper(task_proxy);
+    int num_ops = task_proxy.get_operators().size();
+    for (int gen = 0; gen < symmetries->get_num_generators(); ++gen) {
+        operator_mapping_by_generator.push_back(
+            operator_mapper.compute_operator_mapping(
+                symmetries->get_permutation(gen)));
+        if (static_cast<int>(operator_mapping_by_generator[gen].size()) ==
+            num_ops) {
+            usable_generators.push_back(gen);
+        }
+    }
+}
+
+FactPair CostSaturation::get_symmetric_goal(
+    const shared_ptr<AbstractTask> &subtask) const {
+    /*
+      Symmetries can only be applied to subtasks with the variables and
+      operators of the task, i.e., not to domain-abstracted subtasks.
+    */
+    if (usable_generators.empty()) {
+        return FactPair::no_fact;
+    }
+    TaskProxy subtask_proxy(*subtask);
+    if (subtask_proxy.get_goals().size() != 1 ||
+        get_domain_sizes(subtask_proxy) != domain_sizes) {
+        return FactPair::no_fact;
+    }
+    return subtask_proxy.get_goals()[0].get_pair();
+}
+
+/*
+  Add entries for the orbit of the given goal fact that refer to the given
+  abstraction. Return false (without adding entries) if the goal fact is
+  the only fact in its orbit, since then no abstraction can be derived.
+*/
+bool CostSaturation::add_goal_orbit(const FactPair &goal, int abstraction_id) {
+    assert(!orbit_entry_by_goal.count(goal));
+    int first_entry_id = orbit_entries.size();
+    vector<FactPair> orbit = {goal};
+    vector<OrbitEntry> entries = {{abstraction_id, -1, -1}};
+    utils::HashMap<FactPair, int> entry_id_by_fact;
+    entry_id_by_fact[goal] = first_entry_id;
+    for (size_t i = 0; i < orbit.size(); ++i) {
+        for (int gen : usable_generators) {
+            pair<int, int> var_val =
+                symmetries->get_permutation(gen).get_new_var_val_by_old_var_val(
+                    orbit[i].var, orbit[i].value);
+            FactPair image(var_val.first, var_val.second);
+            if (entry_id_by_fact.count(image)) {
+                continue;
+            }
+            entry_id_by_fact[image] = first_entry_id + orbit.size();
+            int parent = first_entry_id + i;
+            entries.push_back({abstraction_id, parent, gen});
+            orbit.push_back(image);
+        }
+    }
+    if (orbit.size() == 1) {
+        return false;
+    }
+    orbit_entries.insert(orbit_entries.end(), entries.begin(), entries.end());
+    for (const auto &fact_and_entry_id : entry_id_by_fact) {
+        orbit_entry_by_goal.insert(fact_and_entry_id);
+    }
+    return true;
+}
+
+int CostSaturation::find_symmetric_abstraction(const FactPair &goal) const {
+    auto it = orbit_entry_by_goal.find(goal);
+    if (it == orbit_entry_by_goal.end()) {
+        return -1;
+    }
+    // The image has the size of the refined abstraction.
+    const SymmetricAbstraction &abstraction =
+        symmetric_abstractions[orbit_entries[it->second].abstraction_id];
+    if (num_states + abstraction.num_states > max_states ||
+        num_non_looping_transitions +
+        abstraction.transition_system->get_num_non_loops() >
+        max_non_looping_transitions) {
+        return -1;
+    }
+    return it->second;
+}
+
+vector<int> CostSaturation::add_heuristic_function(
+    unique_ptr<RefinementHierarchy> &&refinement_hierarchy,
+    const TransitionSystem &transition_system,
+    const vector<int> &costs,
+    int init_id,
+    const Goals &goals) {
+    vector<int> init_distances = compute_distances(
+        transition_system.get_outgoing_transitions(), costs, {init_id});
+    vector<int> goal_distances = compute_distances(
+        transition_system.get_incoming_transitions(), costs, goals);
+    vector<int> saturated_costs = compute_saturated_costs(
+        transition_system,
+        init_distances,
+        goal_distances,
+        use_general_costs);
+
+    heuristic_functions.emplace_back(
+        move(refinement_hierarchy),
+        move(goal_distances));
+    return saturated_costs;
+}
+
+void CostSaturation::derive_abstraction(
+    const shared_ptr<AbstractTask> &subtask, int entry_id) {
+    const OrbitEntry &entry = orbit_entries[entry_id];
+    const SymmetricAbstraction &abstraction =
+        symmetric_abstractions[entry.abstraction_id];
+
+    // Collect the generators on the path from the refined goal fact.
+    vector<int> generators;
+    for (int id = entry_id; orbit_entries[id].parent != -1;
+         id = orbit_entries[id].parent) {
+        generators.push_back(orbit_entries[id].generator);
+    }
+    reverse(generators.begin(), generators.end());
+
+    int num_variables = domain_sizes.size();
+    vector<vector<FactPair>> fact_mapping(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        for (int value = 0; value < domain_sizes[var]; ++value) {
+            fact_mapping[var].emplace_back(var, value);
+        }
+    }
+    int num_ops = abstraction.transition_system->get_num_operators();
+    vector<int> operator_mapping(num_ops);
+    iota(operator_mapping.begin(), operator_mapping.end(), 0);
+    for (int gen : generators) {
+        const Permutation &generator = symmetries->get_permutation(gen);
+        for (vector<FactPair> &images : fact_mapping) {
+            for (FactPair &image : images) {
+                pair<int, int> var_val =
+                    generator.get_new_var_val_by_old_var_val(
+                        image.var, image.value);
+                image = FactPair(var_val.first, var_val.second);
+            }
+        }
+        for (int &op_id : operator_mapping) {
+            op_id = operator_mapping_by_generator[gen][op_id];
+        }
+    }
+
+    unique_ptr<RefinementHierarchy> refinement_hierarchy =
+        heuristic_functions[abstraction.heuristic_function_id].
+        get_refinement_hierarchy().create_mapped_copy(subtask, fact_mapping);
+    TaskProxy subtask_proxy(*subtask);
+    int init_id = refinement_hierarchy->get_abstract_state_id(
+        subtask_proxy.get_initial_state());
+
+    // The transition system uses the operators of the refined subtask.
+    vector<int> subtask_costs = task_properties::get_operator_costs(subtask_proxy);
+    vector<int> costs(num_ops);
+    for (int op_id = 0; op_id < num_ops; ++op_id) {
+        costs[op_id] = subtask_costs[operator_mapping[op_id]];
+    }
+    vector<int> abstraction_saturated_costs = add_heuristic_function(
+        move(refinement_hierarchy),
+        *abstraction.transition_system,
+        costs,
+        init_id,
+        abstraction.goals);
+    vector<int> saturated_costs(num_ops);
+    for (int op_id = 0; op_id < num_ops; ++op_id) {
+        saturated_costs[operator_mapping[op_id]] =
+            abstraction_saturated_costs[op_id];
+    }
+
+    ++num_abstractions;
+    ++num_derived_abstractions;
+    num_states += abstraction.num_states;
+    num_non_looping_transitions +=
+        abstraction.transition_system->get_num_non_loops();
+    assert(num_states <= max_states);
+
+    reduce_remaining_costs(saturated_costs);
+}
+
 void CostSaturation::reduce_remaining_costs(
     const vector<int> &saturated_costs) {
     assert(remaining_costs.size() == saturated_costs.size());
@@ -195,6 +422,19 @@ void CostSaturation::build_abstractions(
     for (shared_ptr<AbstractTask> subtask : subtasks) {
         subtask = get_remaining_costs_task(subtask);
 
+        FactPair goal = get_symmetric_goal(subtask);
+        int entry_id = -1;
+        if (goal != FactPair::no_fact) {
+            entry_id = find_symmetric_abstraction(goal);
+        }
+        if (entry_id != -1) {
+            derive_abstraction(subtask, entry_id);
+            if (should_abort())
+                break;
+            --rem_subtasks;
+            continue;
+        }
+
         assert(num_states < max_states);
         CEGAR cegar(
             subtask,
@@ -213,23 +453,22 @@ void CostSaturation::build_abstractions(
         assert(num_states <= max_states);
 
         vector<int> costs = task_properties::get_operator_costs(TaskProxy(*subtask));
-        vector<int> init_distances = compute_distances(
-            abstraction->get_transition_system().get_outgoing_transitions(),
-            costs,
-            {abstraction->get_initial_state().get_id()});
-        vector<int> goal_distances = compute_distances(
-            abstraction->get_transition_system().get_incoming_transitions(),
+        vector<int> saturated_costs = add_heuristic_function(
+            abstraction->extract_refinement_hierarchy(),
+            abstraction->get_transition_system(),
             costs,
+            abstraction->get_initial_state().get_id(),
             abstraction->get_goals());
-        vector<int> saturated_costs = compute_saturated_costs(
-            abstraction->get_transition_system(),
-            init_distances,
-            goal_distances,
-            use_general_costs);
 
-        heuristic_functions.emplace_back(
-            abstraction->extract_refinement_hierarchy(),
-            move(goal_distances));
+        // Only keep the transition system if it can be reused.
+        if (goal != FactPair::no_fact && !orbit_entry_by_goal.count(goal) &&
+            add_goal_orbit(goal, symmetric_abstractions.size())) {
+            symmetric_abstractions.push_back(
+                {static_cast<int>(heuristic_functions.size()) - 1,
+                 abstraction->extract_transition_system(),
+                 abstraction->get_goals(),
+                 abstraction->get_num_states()});
+        }
 
         reduce_remaining_costs(saturated_costs);
 
@@ -249,6 +488,10 @@ void CostSaturation::print_statistics(utils::Duration init_time) const {
         log << "Cartesian states: " << num_states << endl;
         log << "Total number of non-looping transitions: "
             << num_non_looping_transitions << endl;
+        if (symmetries) {
+            log << "Cartesian abstractions derived from symmetric "
+                << "abstractions: " << num_derived_abstractions << endl;
+        }
         log << endl;
     }
 }
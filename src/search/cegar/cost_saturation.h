@@ -3,10 +3,17 @@
 
 #include "refinement_hierarchy.h"
 #include "split_selector.h"
+#include "types.h"
+
+#include "../abstract_task.h"
+
+#include "../utils/hash.h"
 
 #include <memory>
 #include <vector>
 
+class Group;
+
 namespace utils {
 class CountdownTimer;
 class Duration;
@@ -17,6 +24,7 @@ class LogProxy;
 namespace cegar {
 class CartesianHeuristicFunction;
 class SubtaskGenerator;
+class TransitionSystem;
 
 /*
   Get subtasks from SubtaskGenerators, reduce their costs by wrapping
@@ -24,8 +32,32 @@ class SubtaskGenerator;
   RefinementHierarchies from Abstractions to
   CartesianHeuristicFunctions, allow extracting
   CartesianHeuristicFunctions into AdditiveCartesianHeuristic.
+
+  If symmetries are given, subtasks with a single goal fact that is the
+  image of the goal fact of an already refined subtask under a symmetry
+  are not refined. Instead, their abstraction is the image of the refined
+  abstraction: it shares its transition system and abstract goals, and its
+  refinement hierarchy splits on the mapped facts. Goal distances and
+  saturated costs are computed for the remaining costs as usual, mapping
+  operators between the two subtasks.
 */
 class CostSaturation {
+    // Refined abstraction whose images can be used for symmetric subtasks.
+    struct SymmetricAbstraction {
+        int heuristic_function_id;
+        std::unique_ptr<TransitionSystem> transition_system;
+        Goals goals;
+        int num_states;
+    };
+
+    // Entry for a goal fact in the orbit of a refined goal fact.
+    struct OrbitEntry {
+        int abstraction_id;
+        // Index of the predecessor entry or -1 for the refined goal fact.
+        int parent;
+        int generator;
+    };
+
     const std::vector<std::shared_ptr<SubtaskGenerator>> subtask_generators;
     const int max_states;
     const int max_non_looping_transitions;
@@ -34,6 +66,7 @@ class CostSaturation {
     const PickSplit pick_split;
     utils::RandomNumberGenerator &rng;
     utils::LogProxy &log;
+    const std::shared_ptr<Group> symmetries;
 
     std::vector<CartesianHeuristicFunction> heuristic_functions;
     std::vector<int> remaining_costs;
@@ -41,7 +74,28 @@ class CostSaturation {
     int num_states;
     int num_non_looping_transitions;
 
+    std::vector<int> domain_sizes;
+    std::vector<std::vector<int>> operator_mapping_by_generator;
+    // Generators that map the operators of the task onto each other.
+    std::vector<int> usable_generators;
+    std::vector<SymmetricAbstraction> symmetric_abstractions;
+    std::vector<OrbitEntry> orbit_entries;
+    utils::HashMap<FactPair, int> orbit_entry_by_goal;
+    int num_derived_abstractions;
+
     void reset(const TaskProxy &task_proxy);
+    void initialize_symmetries(const TaskProxy &task_proxy);
+    FactPair get_symmetric_goal(const std::shared_ptr<AbstractTask> &subtask) const;
+    bool add_goal_orbit(const FactPair &goal, int abstraction_id);
+    int find_symmetric_abstraction(const FactPair &goal) const;
+    std::vector<int> add_heuristic_function(
+        std::unique_ptr<RefinementHierarchy> &&refinement_hierarchy,
+        const TransitionSystem &transition_system,
+        const std::vector<int> &costs,
+        int init_id,
+        const Goals &goals);
+    void derive_abstraction(
+        const std::shared_ptr<AbstractTask> &subtask, int entry_id);
     void reduce_remaining_costs(const std::vector<int> &saturated_costs);
     std::shared_ptr<AbstractTask> get_remaining_costs_task(
         std::shared_ptr<AbstractTask> &parent) const;
@@ -61,7 +115,9 @@ public:
         bool use_general_costs,
         PickSplit pick_split,
         utils::RandomNumberGenerator &rng,
-        utils::LogProxy &log);
+        utils::LogProxy &log,
+        const std::shared_ptr<Group> &symmetries = nullptr);
+    ~CostSaturation();
 
     std::vector<CartesianHeuristicFunction> generate_heuristic_functions(
         const std::shared_ptr<AbstractTask> &task);
@@ -2,6 +2,8 @@
 
 #include "../task_proxy.h"
 
+#include "../utils/memory.h"
+
 using namespace std;
 
 namespace cegar {
@@ -36,6 +38,13 @@ void Node::split(int var, int value, NodeID left_child, NodeID right_child) {
     assert(is_split());
 }
 
+void Node::map_split_fact(const vector<vector<FactPair>> &fact_mapping) {
+    assert(is_split());
+    const FactPair &image = fact_mapping[var][value];
+    var = image.var;
+    value = image.value;
+}
+
 
 
 ostream &operator<<(ostream &os, const Node &node) {
@@ -82,4 +91,18 @@ int RefinementHierarchy::get_abstract_state_id(const State &state) const {
     State subtask_state = subtask_proxy.convert_ancestor_state(state);
     return nodes[get_node_id(subtask_state)].get_state_id();
 }
+
+unique_ptr<RefinementHierarchy> RefinementHierarchy::create_mapped_copy(
+    const shared_ptr<AbstractTask> &task,
+    const vector<vector<FactPair>> &fact_mapping) const {
+    unique_ptr<RefinementHierarchy> copy =
+        utils::make_unique_ptr<RefinementHierarchy>(task);
+    copy->nodes = nodes;
+    for (Node &node : copy->nodes) {
+        if (node.is_split()) {
+            node.map_split_fact(fact_mapping);
+        }
+    }
+    return copy;
+}
 }
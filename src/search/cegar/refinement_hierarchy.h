@@ -11,6 +11,7 @@
 
 class AbstractTask;
 class State;
+struct FactPair;
 
 namespace cegar {
 class Node;
@@ -48,6 +49,17 @@ public:
         int left_state_id, int right_state_id);
 
     int get_abstract_state_id(const State &state) const;
+
+    /*
+      Return a copy of the hierarchy for the given task in which the fact of
+      every split is replaced by its image under fact_mapping (indexed by
+      variable and value). If fact_mapping is a structural symmetry, the
+      copy represents the image of the abstraction under the symmetry and
+      has the same abstract state IDs.
+    */
+    std::unique_ptr<RefinementHierarchy> create_mapped_copy(
+        const std::shared_ptr<AbstractTask> &task,
+        const std::vector<std::vector<FactPair>> &fact_mapping) const;
 };
 
 
@@ -78,6 +90,9 @@ public:
 
     void split(int var, int value, NodeID left_child, NodeID right_child);
 
+    // Replace the fact of the split by its image under the mapping.
+    void map_split_fact(const std::vector<std::vector<FactPair>> &fact_mapping);
+
     int get_var() const {
         assert(is_split());
         return var;
@@ -7,6 +7,7 @@
 #include "options/doc_printer.h"
 #include "options/predefinitions.h"
 #include "options/registries.h"
+#include "utils/spillable_memory.h"
 #include "utils/strings.h"
 
 #include <algorithm>
@@ -105,6 +106,12 @@ static shared_ptr<SearchEngine> parse_cmd_line_aux(
             num_previously_generated_plans = parse_int_arg(arg, args[i]);
             if (num_previously_generated_plans < 0)
                 throw ArgError("argument for --internal-previous-portfolio-plans must be positive");
+        } else if (arg == "--spill-directory") {
+            if (is_last)
+                throw ArgError("missing argument after --spill-directory");
+            ++i;
+            if (!dry_run)
+                utils::set_spill_directory(args[i]);
         } else if (utils::startswith(arg, "--") &&
                    registry.is_predefinition(arg.substr(2))) {
             if (is_last)
@@ -171,5 +178,12 @@ string usage(const string &progname) {
            "    This planner call is part of a portfolio which already created\n"
            "    plan files FILENAME.1 up to FILENAME.COUNTER.\n"
            "    Start enumerating plan files with COUNTER+1, i.e. FILENAME.COUNTER+1\n\n"
+           "--spill-directory DIRECTORY\n"
+           "    Store the state data and per-state information in files in\n"
+           "    DIRECTORY that are mapped into memory, so that the operating\n"
+           "    system can write rarely used parts to disk when RAM runs out.\n"
+           "    The files do not count towards the memory limit of the driver.\n"
+           "    Under an address-space limit set otherwise (e.g., ulimit -v),\n"
+           "    they are only exempt if the hard limit exceeds the soft limit.\n\n"
            "See https://www.fast-downward.org for details.";
 }
@@ -55,6 +55,33 @@ const EvaluationResult &EvaluationContext::get_result(Evaluator *evaluator) {
     return result;
 }
 
+void EvaluationContext::evaluate_batch(
+    const vector<EvaluationContext *> &eval_contexts, Evaluator *eval) {
+    vector<EvaluationContext *> missing_contexts;
+    missing_contexts.reserve(eval_contexts.size());
+    for (EvaluationContext *eval_context : eval_contexts) {
+        if (eval_context->cache[eval].is_uninitialized()) {
+            missing_contexts.push_back(eval_context);
+        }
+    }
+    if (missing_contexts.empty()) {
+        return;
+    }
+    vector<EvaluationResult> results;
+    eval->compute_results(missing_contexts, results);
+    assert(results.size() == missing_contexts.size());
+    for (size_t i = 0; i < missing_contexts.size(); ++i) {
+        EvaluationContext &eval_context = *missing_contexts[i];
+        const EvaluationResult &result = results[i];
+        eval_context.cache[eval] = result;
+        if (eval_context.statistics &&
+            eval->is_used_for_counting_evaluations() &&
+            result.get_count_evaluation()) {
+            eval_context.statistics->inc_evaluations();
+        }
+    }
+}
+
 const EvaluatorCache &EvaluationContext::get_cache() const {
     return cache;
 }
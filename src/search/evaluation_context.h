@@ -7,6 +7,7 @@
 #include "task_proxy.h"
 
 #include <unordered_map>
+#include <vector>
 
 class Evaluator;
 class SearchStatistics;
@@ -89,6 +90,14 @@ public:
         SearchStatistics *statistics = nullptr, bool calculate_preferred = false);
 
     const EvaluationResult &get_result(Evaluator *eval);
+    /*
+      Compute the results of the evaluator for all given contexts that do
+      not contain one yet with a single call to Evaluator::compute_results
+      and cache them in the contexts.
+    */
+    static void evaluate_batch(
+        const std::vector<EvaluationContext *> &eval_contexts,
+        Evaluator *eval);
     const EvaluatorCache &get_cache() const;
     const State &get_state() const;
     int get_g_value() const;
@@ -25,6 +25,16 @@ bool Evaluator::dead_ends_are_reliable() const {
     return true;
 }
 
+void Evaluator::compute_results(
+    const vector<EvaluationContext *> &eval_contexts,
+    vector<EvaluationResult> &results) {
+    results.clear();
+    results.reserve(eval_contexts.size());
+    for (EvaluationContext *eval_context : eval_contexts) {
+        results.push_back(compute_result(*eval_context));
+    }
+}
+
 void Evaluator::report_value_for_initial_state(
     const EvaluationResult &result) const {
     if (log.is_at_least_normal()) {
@@ -6,6 +6,7 @@
 #include "../utils/logging.h"
 
 #include <set>
+#include <vector>
 
 class EvaluationContext;
 class State;
@@ -84,6 +85,21 @@ public:
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) = 0;
 
+    /*
+      compute_results should compute the results for a batch of
+      evaluation contexts, e.g., for all successors of an expanded
+      state, and store them in the same order in results. As for
+      compute_result, the results are added to the evaluation contexts
+      elsewhere (see EvaluationContext::evaluate_batch).
+
+      Evaluators can override this to share work between the states
+      of the batch. The default implementation calls compute_result
+      for every context.
+    */
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &eval_contexts,
+        std::vector<EvaluationResult> &results);
+
     void report_value_for_initial_state(const EvaluationResult &result) const;
     void report_new_minimum_value(const EvaluationResult &result) const;
 
@@ -4,6 +4,8 @@
 #include "../evaluation_result.h"
 #include "../option_parser.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace combining_evaluator {
@@ -47,6 +49,29 @@ EvaluationResult CombiningEvaluator::compute_result(
     return result;
 }
 
+void CombiningEvaluator::compute_results(
+    const vector<EvaluationContext *> &eval_contexts,
+    vector<EvaluationResult> &results) {
+    /*
+      Like compute_result, we only evaluate a subevaluator on the states
+      for which all previous subevaluators have finite values.
+    */
+    vector<EvaluationContext *> finite_eval_contexts = eval_contexts;
+    for (const shared_ptr<Evaluator> &subevaluator : subevaluators) {
+        EvaluationContext::evaluate_batch(
+            finite_eval_contexts, subevaluator.get());
+        finite_eval_contexts.erase(
+            remove_if(finite_eval_contexts.begin(), finite_eval_contexts.end(),
+                      [&](EvaluationContext *eval_context) {
+                          return eval_context->is_evaluator_value_infinite(
+                              subevaluator.get());
+                      }),
+            finite_eval_contexts.end());
+    }
+    // All subevaluator values that compute_result needs are cached now.
+    Evaluator::compute_results(eval_contexts, results);
+}
+
 void CombiningEvaluator::get_path_dependent_evaluators(
     set<Evaluator *> &evals) {
     for (auto &subevaluator : subevaluators)
@@ -38,6 +38,10 @@ public:
     virtual bool dead_ends_are_reliable() const override;
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) override;
+    // Evaluate each subevaluator for the whole batch at once.
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &eval_contexts,
+        std::vector<EvaluationResult> &results) override;
 
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) override;
@@ -0,0 +1,148 @@
+#include "symmetric_cache_evaluator.h"
+
+#include "../evaluation_context.h"
+#include "../evaluation_result.h"
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../structural_symmetries/group.h"
+#include "../tasks/root_task.h"
+#include "../utils/system.h"
+
+using namespace std;
+
+namespace symmetric_cache_evaluator {
+static const int NO_VALUE = -1;
+
+SymmetricCacheEvaluator::SymmetricCacheEvaluator(const Options &opts)
+    : Evaluator(opts),
+      evaluator(opts.get<shared_ptr<Evaluator>>("eval")),
+      group(opts.get<shared_ptr<Group>>("symmetries")),
+      canonical_registry(TaskProxy(*tasks::g_root_task)),
+      cached_values(NO_VALUE),
+      num_lookups(0),
+      num_hits(0),
+      num_evaluations(0),
+      lookup_timer(false),
+      evaluation_timer(false) {
+    /*
+      Sharing estimates between symmetric states is only sound if they have
+      the same goal distance, i.e., if the symmetries map goal states to
+      goal states.
+    */
+    if (!group->is_stabilizing_goal()) {
+        cerr << "Symmetric cache requires symmetries that stabilize the goal."
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+    // The estimates of path-dependent evaluators depend on more than the state.
+    set<Evaluator *> path_dependent_evaluators;
+    evaluator->get_path_dependent_evaluators(path_dependent_evaluators);
+    if (!path_dependent_evaluators.empty()) {
+        cerr << "Symmetric cache does not support path-dependent evaluators."
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+    if (!group->is_initialized()) {
+        log << "Initializing symmetries (symmetric cache)" << endl;
+        group->compute_symmetries(TaskProxy(*tasks::g_root_task));
+    }
+}
+
+SymmetricCacheEvaluator::~SymmetricCacheEvaluator() {
+    print_statistics();
+}
+
+bool SymmetricCacheEvaluator::dead_ends_are_reliable() const {
+    return evaluator->dead_ends_are_reliable();
+}
+
+EvaluationResult SymmetricCacheEvaluator::compute_result(
+    EvaluationContext &eval_context) {
+    const State &state = eval_context.get_state();
+    if (eval_context.get_calculate_preferred() || !group->has_symmetries() ||
+        !state.get_registry()) {
+        return eval_context.get_result(evaluator.get());
+    }
+
+    ++num_lookups;
+    lookup_timer.resume();
+    State canonical_state =
+        canonical_registry.register_canonical_state(state, *group);
+    lookup_timer.stop();
+
+    EvaluationResult result;
+    int &cached_value = cached_values[canonical_state];
+    if (cached_value != NO_VALUE) {
+        ++num_hits;
+        result.set_evaluator_value(cached_value);
+    } else {
+        ++num_evaluations;
+        evaluation_timer.resume();
+        result = eval_context.get_result(evaluator.get());
+        evaluation_timer.stop();
+        cached_value = result.get_evaluator_value();
+    }
+    return result;
+}
+
+void SymmetricCacheEvaluator::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    evaluator->get_path_dependent_evaluators(evals);
+}
+
+void SymmetricCacheEvaluator::print_statistics() const {
+    log << "Symmetric cache lookups: " << num_lookups << endl;
+    log << "Symmetric cache hits: " << num_hits << endl;
+    if (num_lookups > 0) {
+        log << "Symmetric cache hit rate: "
+            << static_cast<double>(num_hits) / num_lookups << endl;
+    }
+    log << "Symmetric cache lookup time: " << lookup_timer << endl;
+    log << "Symmetric cache evaluation time: " << evaluation_timer << endl;
+    if (num_evaluations > 0) {
+        /*
+          Estimate the time saved by assuming that every hit would have
+          taken as long as an average evaluation on a cache miss.
+        */
+        double saved_time =
+            evaluation_timer() / num_evaluations * num_hits - lookup_timer();
+        log << "Symmetric cache estimated time saved: " << saved_time
+            << "s" << endl;
+    }
+}
+
+static shared_ptr<Evaluator> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Symmetric cache evaluator",
+        "Caches the estimates of the given evaluator by the canonical "
+        "representatives of the evaluated states under the given "
+        "structural symmetries, so that symmetric states are evaluated "
+        "only once.");
+    parser.document_note(
+        "Supported evaluators",
+        "The evaluator must not be path-dependent and the symmetries must "
+        "stabilize the goal. Since symmetric states "
+        "have the same goal distance, caching preserves admissibility, but "
+        "evaluators that break ties differently in symmetric states may "
+        "return estimates that differ from a direct evaluation.");
+    parser.document_note(
+        "Preferred operators",
+        "Preferred operators cannot be transferred between symmetric states. "
+        "States for which preferred operators are requested are always "
+        "evaluated by the wrapped evaluator.");
+    parser.add_option<shared_ptr<Evaluator>>("eval", "evaluator to cache");
+    parser.add_option<shared_ptr<Group>>(
+        "symmetries",
+        "symmetries object to compute structural symmetries for caching");
+    add_evaluator_options_to_parser(parser);
+
+    Options opts = parser.parse();
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return make_shared<SymmetricCacheEvaluator>(opts);
+}
+
+static Plugin<Evaluator> _plugin("symmetric_cache", _parse, "evaluators_basic");
+}
@@ -0,0 +1,56 @@
+#ifndef EVALUATORS_SYMMETRIC_CACHE_EVALUATOR_H
+#define EVALUATORS_SYMMETRIC_CACHE_EVALUATOR_H
+
+#include "../evaluator.h"
+#include "../per_state_information.h"
+#include "../state_registry.h"
+
+#include "../utils/timer.h"
+
+#include <memory>
+
+class Group;
+
+namespace symmetric_cache_evaluator {
+/*
+  Caches the estimates of a state-dependent evaluator by the canonical
+  representatives of the evaluated states, so that symmetric states share
+  a single evaluation. This is useful if symmetries are computed but the
+  search does not prune symmetric states (e.g., with tie-breaking open
+  lists or in satisficing search).
+
+  The canonical representatives are registered in a registry owned by this
+  evaluator. Preferred operators are specific to a state and cannot be
+  transferred to symmetric states, so states for which preferred operators
+  are requested are always evaluated.
+*/
+class SymmetricCacheEvaluator : public Evaluator {
+    std::shared_ptr<Evaluator> evaluator;
+    std::shared_ptr<Group> group;
+
+    StateRegistry canonical_registry;
+    PerStateInformation<int> cached_values;
+
+    int num_lookups;
+    int num_hits;
+    int num_evaluations;
+    // Time for canonicalizing and registering the evaluated states.
+    utils::Timer lookup_timer;
+    // Time spent in the wrapped evaluator on cache misses.
+    utils::Timer evaluation_timer;
+
+    void print_statistics() const;
+public:
+    explicit SymmetricCacheEvaluator(const options::Options &opts);
+    virtual ~SymmetricCacheEvaluator() override;
+
+    virtual bool dead_ends_are_reliable() const override;
+    virtual EvaluationResult compute_result(
+        EvaluationContext &eval_context) override;
+
+    virtual void get_path_dependent_evaluators(
+        std::set<Evaluator *> &evals) override;
+};
+}
+
+#endif
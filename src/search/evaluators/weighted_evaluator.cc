@@ -37,6 +37,13 @@ EvaluationResult WeightedEvaluator::compute_result(
     return result;
 }
 
+void WeightedEvaluator::compute_results(
+    const vector<EvaluationContext *> &eval_contexts,
+    vector<EvaluationResult> &results) {
+    EvaluationContext::evaluate_batch(eval_contexts, evaluator.get());
+    Evaluator::compute_results(eval_contexts, results);
+}
+
 void WeightedEvaluator::get_path_dependent_evaluators(set<Evaluator *> &evals) {
     evaluator->get_path_dependent_evaluators(evals);
 }
@@ -9,6 +9,8 @@
 #include "tasks/cost_adapted_task.h"
 #include "tasks/root_task.h"
 
+#include "utils/language.h"
+
 #include <cassert>
 #include <cstdlib>
 #include <limits>
@@ -44,27 +46,71 @@ void Heuristic::add_options_to_parser(OptionParser &parser) {
     parser.add_option<bool>("cache_estimates", "cache heuristic estimates", "true");
 }
 
-EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
-    EvaluationResult result;
+void Heuristic::compute_heuristics(
+    const vector<State> &ancestor_states, vector<int> &values) {
+    values.clear();
+    values.reserve(ancestor_states.size());
+    for (const State &state : ancestor_states) {
+        values.push_back(compute_heuristic(state));
+        preferred_operators.clear();
+    }
+}
 
+EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
     assert(preferred_operators.empty());
 
     const State &state = eval_context.get_state();
     bool calculate_preferred = eval_context.get_calculate_preferred();
 
-    int heuristic = NO_VALUE;
-
     if (!calculate_preferred && cache_evaluator_values &&
         heuristic_cache[state].h != NO_VALUE && !heuristic_cache[state].dirty) {
-        heuristic = heuristic_cache[state].h;
-        result.set_count_evaluation(false);
-    } else {
-        heuristic = compute_heuristic(state);
+        return create_result(state, heuristic_cache[state].h, false);
+    }
+    int heuristic = compute_heuristic(state);
+    if (cache_evaluator_values) {
+        heuristic_cache[state] = HEntry(heuristic, false);
+    }
+    return create_result(state, heuristic, true);
+}
+
+void Heuristic::compute_results(
+    const vector<EvaluationContext *> &eval_contexts,
+    vector<EvaluationResult> &results) {
+    results.assign(eval_contexts.size(), EvaluationResult());
+    vector<State> states;
+    vector<int> batch_indices;
+    for (size_t i = 0; i < eval_contexts.size(); ++i) {
+        EvaluationContext &eval_context = *eval_contexts[i];
+        const State &state = eval_context.get_state();
+        if (eval_context.get_calculate_preferred()) {
+            results[i] = compute_result(eval_context);
+        } else if (cache_evaluator_values &&
+                   heuristic_cache[state].h != NO_VALUE &&
+                   !heuristic_cache[state].dirty) {
+            results[i] = create_result(state, heuristic_cache[state].h, false);
+        } else {
+            states.push_back(state);
+            batch_indices.push_back(i);
+        }
+    }
+    if (states.empty()) {
+        return;
+    }
+    vector<int> values;
+    compute_heuristics(states, values);
+    assert(values.size() == states.size());
+    for (size_t j = 0; j < states.size(); ++j) {
         if (cache_evaluator_values) {
-            heuristic_cache[state] = HEntry(heuristic, false);
+            heuristic_cache[states[j]] = HEntry(values[j], false);
         }
-        result.set_count_evaluation(true);
+        results[batch_indices[j]] = create_result(states[j], values[j], true);
     }
+}
+
+EvaluationResult Heuristic::create_result(
+    const State &state, int heuristic, bool count_evaluation) {
+    EvaluationResult result;
+    result.set_count_evaluation(count_evaluation);
 
     assert(heuristic == DEAD_END || heuristic >= 0);
 
@@ -88,6 +134,7 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
             assert(task_properties::is_applicable(global_operators[op_id], state));
     }
 #endif
+    utils::unused_variable(state);
 
     result.set_evaluator_value(heuristic);
     result.set_preferred_operators(preferred_operators.pop_as_vector());
@@ -44,6 +44,9 @@ class Heuristic : public Evaluator {
     */
     ordered_set::OrderedSet<OperatorID> preferred_operators;
 
+    EvaluationResult create_result(
+        const State &state, int heuristic, bool count_evaluation);
+
 protected:
     /*
       Cache for saving h values
@@ -63,6 +66,16 @@ protected:
 
     virtual int compute_heuristic(const State &ancestor_state) = 0;
 
+    /*
+      Compute the heuristic values of a batch of states and store them
+      in the same order in values. Preferred operators are not needed.
+      Heuristics can override this to share work between the states, e.g.,
+      by computing the values for all states one variable at a time. The
+      default implementation calls compute_heuristic for every state.
+    */
+    virtual void compute_heuristics(
+        const std::vector<State> &ancestor_states, std::vector<int> &values);
+
     /*
       Usage note: Marking the same operator as preferred multiple times
       is OK -- it will only appear once in the list of preferred
@@ -84,6 +97,9 @@ public:
 
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) override;
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &eval_contexts,
+        std::vector<EvaluationResult> &results) override;
 
     virtual bool does_cache_estimates() const override;
     virtual bool is_estimate_cached(const State &state) const override;
@@ -29,6 +29,29 @@ int GoalCountHeuristic::compute_heuristic(const State &ancestor_state) {
     return unsatisfied_goal_count;
 }
 
+void GoalCountHeuristic::compute_heuristics(
+    const vector<State> &ancestor_states, vector<int> &values) {
+    int num_states = ancestor_states.size();
+    vector<State> states;
+    states.reserve(num_states);
+    vector<const int *> state_values;
+    state_values.reserve(num_states);
+    for (const State &ancestor_state : ancestor_states) {
+        states.push_back(convert_ancestor_state(ancestor_state));
+        states.back().unpack();
+        state_values.push_back(states.back().get_unpacked_values().data());
+    }
+
+    // Test one goal for all states at a time, without branches.
+    values.assign(num_states, 0);
+    for (FactProxy goal : task_proxy.get_goals()) {
+        FactPair goal_fact = goal.get_pair();
+        for (int i = 0; i < num_states; ++i) {
+            values[i] += (state_values[i][goal_fact.var] != goal_fact.value);
+        }
+    }
+}
+
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_synopsis("Goal count heuristic", "");
     parser.document_language_support("action costs", "ignored by design");
@@ -7,6 +7,9 @@ namespace goal_count_heuristic {
 class GoalCountHeuristic : public Heuristic {
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual void compute_heuristics(
+        const std::vector<State> &ancestor_states,
+        std::vector<int> &values) override;
 public:
     explicit GoalCountHeuristic(const options::Options &opts);
 };
@@ -0,0 +1,398 @@
+#include "lp_folding.h"
+
+#include "lp_solver.h"
+
+#include "../utils/logging.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <utility>
+
+using namespace std;
+
+namespace lp {
+// Bounds and sorted (variable, coefficient) pairs of a constraint.
+using ConstraintSignature =
+    pair<pair<double, double>, vector<pair<int, double>>>;
+
+static ConstraintSignature compute_constraint_signature(
+    const LPConstraint &constraint, const vector<int> *permutation) {
+    const vector<int> &variables = constraint.get_variables();
+    const vector<double> &coefficients = constraint.get_coefficients();
+    vector<pair<int, double>> entries;
+    entries.reserve(variables.size());
+    for (size_t i = 0; i < variables.size(); ++i) {
+        int var = permutation ? (*permutation)[variables[i]] : variables[i];
+        entries.emplace_back(var, coefficients[i]);
+    }
+    sort(entries.begin(), entries.end());
+    return make_pair(
+        make_pair(constraint.get_lower_bound(), constraint.get_upper_bound()),
+        move(entries));
+}
+
+static bool is_variable_symmetry(
+    const named_vector::NamedVector<LPVariable> &variables,
+    const vector<int> &permutation) {
+    for (int var = 0; var < variables.size(); ++var) {
+        const LPVariable &variable = variables[var];
+        const LPVariable &image = variables[permutation[var]];
+        if (variable.lower_bound != image.lower_bound ||
+            variable.upper_bound != image.upper_bound ||
+            variable.objective_coefficient != image.objective_coefficient ||
+            variable.is_integer != image.is_integer) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+  Return the permutation of the constraints induced by the variable
+  permutation or an empty vector if some constraint is not mapped onto a
+  constraint. Identical constraints are interchangeable, so the i-th
+  constraint with a given image signature is mapped onto the i-th
+  constraint with this signature.
+*/
+static vector<int> compute_constraint_permutation(
+    const named_vector::NamedVector<LPConstraint> &constraints,
+    const map<ConstraintSignature, vector<int>> &constraints_by_signature,
+    const vector<int> &variable_permutation) {
+    vector<int> permutation;
+    permutation.reserve(constraints.size());
+    map<ConstraintSignature, int> num_mapped_constraints_by_signature;
+    for (const LPConstraint &constraint : constraints) {
+        ConstraintSignature image_signature =
+            compute_constraint_signature(constraint, &variable_permutation);
+        auto it = constraints_by_signature.find(image_signature);
+        if (it == constraints_by_signature.end()) {
+            return {};
+        }
+        int &num_mapped = num_mapped_constraints_by_signature[image_signature];
+        assert(num_mapped < static_cast<int>(it->second.size()));
+        permutation.push_back(it->second[num_mapped++]);
+    }
+    return permutation;
+}
+
+/*
+  Assign consecutive IDs to the orbits of the elements under the
+  permutations, ordered by their smallest element.
+*/
+static vector<int> compute_orbit_ids(
+    int num_elements, const vector<vector<int>> &permutations,
+    int &num_orbits) {
+    vector<int> orbit_ids(num_elements, -1);
+    num_orbits = 0;
+    vector<int> queue;
+    for (int element = 0; element < num_elements; ++element) {
+        if (orbit_ids[element] != -1) {
+            continue;
+        }
+        orbit_ids[element] = num_orbits;
+        queue.assign(1, element);
+        while (!queue.empty()) {
+            int current = queue.back();
+            queue.pop_back();
+            for (const vector<int> &permutation : permutations) {
+                int image = permutation[current];
+                if (orbit_ids[image] == -1) {
+                    orbit_ids[image] = num_orbits;
+                    queue.push_back(image);
+                }
+            }
+        }
+        ++num_orbits;
+    }
+    return orbit_ids;
+}
+
+LPFolding::LPFolding(
+    const LinearProgram &lp,
+    const vector<vector<int>> &variable_permutations)
+    : infinity(lp.get_infinity()),
+      num_symmetries(0),
+      num_folded_constraints(0) {
+    const named_vector::NamedVector<LPVariable> &variables = lp.get_variables();
+    const named_vector::NamedVector<LPConstraint> &constraints =
+        lp.get_constraints();
+
+    for (const LPVariable &variable : variables) {
+        if (variable.is_integer) {
+            cerr << "Folding LPs with integer variables is not supported."
+                 << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+        }
+        variable_lower_bounds.push_back(variable.lower_bound);
+        variable_upper_bounds.push_back(variable.upper_bound);
+        objective_coefficients.push_back(variable.objective_coefficient);
+    }
+
+    map<ConstraintSignature, vector<int>> constraints_by_signature;
+    for (int id = 0; id < constraints.size(); ++id) {
+        const LPConstraint &constraint = constraints[id];
+        constraints_by_signature[compute_constraint_signature(
+                                     constraint, nullptr)].push_back(id);
+        constraint_lower_bounds.push_back(constraint.get_lower_bound());
+        constraint_upper_bounds.push_back(constraint.get_upper_bound());
+    }
+
+    vector<vector<int>> symmetries;
+    vector<vector<int>> constraint_permutations;
+    for (const vector<int> &permutation : variable_permutations) {
+        assert(permutation.size() == static_cast<size_t>(variables.size()));
+        if (!is_variable_symmetry(variables, permutation)) {
+            continue;
+        }
+        vector<int> constraint_permutation = compute_constraint_permutation(
+            constraints, constraints_by_signature, permutation);
+        if (static_cast<int>(constraint_permutation.size()) !=
+            constraints.size()) {
+            continue;
+        }
+        symmetries.push_back(permutation);
+        constraint_permutations.push_back(move(constraint_permutation));
+    }
+    num_symmetries = symmetries.size();
+
+    int num_folded_variables = 0;
+    folded_variable_by_variable = compute_orbit_ids(
+        variables.size(), symmetries, num_folded_variables);
+    variables_by_folded_variable.resize(num_folded_variables);
+    for (int var = 0; var < variables.size(); ++var) {
+        variables_by_folded_variable[folded_variable_by_variable[var]].push_back(
+            var);
+    }
+    folded_constraint_by_constraint = compute_orbit_ids(
+        constraints.size(), constraint_permutations, num_folded_constraints);
+
+    finite_lower_bound_sums.resize(num_folded_constraints, 0);
+    finite_upper_bound_sums.resize(num_folded_constraints, 0);
+    num_infinite_lower_bounds.resize(num_folded_constraints, 0);
+    num_infinite_upper_bounds.resize(num_folded_constraints, 0);
+    for (int id = 0; id < constraints.size(); ++id) {
+        add_constraint_bounds(id);
+    }
+}
+
+bool LPFolding::is_infinite(double value) const {
+    return value <= -infinity || value >= infinity;
+}
+
+double LPFolding::get_folded_variable_lower_bound(int folded_id) const {
+    const vector<int> &orbit = variables_by_folded_variable[folded_id];
+    double sum = 0;
+    for (int var : orbit) {
+        if (is_infinite(variable_lower_bounds[var])) {
+            return -infinity;
+        }
+        sum += variable_lower_bounds[var];
+    }
+    return sum / orbit.size();
+}
+
+double LPFolding::get_folded_variable_upper_bound(int folded_id) const {
+    const vector<int> &orbit = variables_by_folded_variable[folded_id];
+    double sum = 0;
+    for (int var : orbit) {
+        if (is_infinite(variable_upper_bounds[var])) {
+            return infinity;
+        }
+        sum += variable_upper_bounds[var];
+    }
+    return sum / orbit.size();
+}
+
+double LPFolding::get_folded_constraint_lower_bound(int folded_id) const {
+    if (num_infinite_lower_bounds[folded_id] > 0) {
+        return -infinity;
+    }
+    return finite_lower_bound_sums[folded_id];
+}
+
+double LPFolding::get_folded_constraint_upper_bound(int folded_id) const {
+    if (num_infinite_upper_bounds[folded_id] > 0) {
+        return infinity;
+    }
+    return finite_upper_bound_sums[folded_id];
+}
+
+void LPFolding::add_constraint_bounds(int constraint_id) {
+    int folded_id = folded_constraint_by_constraint[constraint_id];
+    double lower_bound = constraint_lower_bounds[constraint_id];
+    double upper_bound = constraint_upper_bounds[constraint_id];
+    if (is_infinite(lower_bound)) {
+        ++num_infinite_lower_bounds[folded_id];
+    } else {
+        finite_lower_bound_sums[folded_id] += lower_bound;
+    }
+    if (is_infinite(upper_bound)) {
+        ++num_infinite_upper_bounds[folded_id];
+    } else {
+        finite_upper_bound_sums[folded_id] += upper_bound;
+    }
+}
+
+void LPFolding::remove_constraint_bounds(int constraint_id) {
+    int folded_id = folded_constraint_by_constraint[constraint_id];
+    double lower_bound = constraint_lower_bounds[constraint_id];
+    double upper_bound = constraint_upper_bounds[constraint_id];
+    if (is_infinite(lower_bound)) {
+        --num_infinite_lower_bounds[folded_id];
+    } else {
+        finite_lower_bound_sums[folded_id] -= lower_bound;
+    }
+    if (is_infinite(upper_bound)) {
+        --num_infinite_upper_bounds[folded_id];
+    } else {
+        finite_upper_bound_sums[folded_id] -= upper_bound;
+    }
+}
+
+LinearProgram LPFolding::create_folded_lp(const LinearProgram &lp) const {
+    named_vector::NamedVector<LPVariable> folded_variables;
+    int num_folded_variables = get_num_folded_variables();
+    folded_variables.reserve(num_folded_variables);
+    for (int folded_id = 0; folded_id < num_folded_variables; ++folded_id) {
+        double objective_coefficient = 0;
+        for (int var : variables_by_folded_variable[folded_id]) {
+            objective_coefficient += objective_coefficients[var];
+        }
+        folded_variables.emplace_back(
+            get_folded_variable_lower_bound(folded_id),
+            get_folded_variable_upper_bound(folded_id),
+            objective_coefficient);
+    }
+
+    vector<map<int, double>> coefficients_by_folded_constraint(
+        num_folded_constraints);
+    const named_vector::NamedVector<LPConstraint> &constraints =
+        lp.get_constraints();
+    for (int id = 0; id < constraints.size(); ++id) {
+        const LPConstraint &constraint = constraints[id];
+        map<int, double> &folded_coefficients =
+            coefficients_by_folded_constraint[folded_constraint_by_constraint[id]];
+        const vector<int> &variables = constraint.get_variables();
+        const vector<double> &coefficients = constraint.get_coefficients();
+        for (size_t i = 0; i < variables.size(); ++i) {
+            folded_coefficients[folded_variable_by_variable[variables[i]]] +=
+                coefficients[i];
+        }
+    }
+    named_vector::NamedVector<LPConstraint> folded_constraints;
+    folded_constraints.reserve(num_folded_constraints);
+    for (int folded_id = 0; folded_id < num_folded_constraints; ++folded_id) {
+        LPConstraint constraint(
+            get_folded_constraint_lower_bound(folded_id),
+            get_folded_constraint_upper_bound(folded_id));
+        for (const pair<const int, double> &entry :
+             coefficients_by_folded_constraint[folded_id]) {
+            if (entry.second != 0) {
+                constraint.insert(entry.first, entry.second);
+            }
+        }
+        folded_constraints.push_back(move(constraint));
+    }
+
+    LinearProgram folded_lp(
+        lp.get_sense(), move(folded_variables), move(folded_constraints),
+        infinity);
+    folded_lp.set_objective_name(lp.get_objective_name());
+    return folded_lp;
+}
+
+int LPFolding::get_num_variables() const {
+    return folded_variable_by_variable.size();
+}
+
+int LPFolding::get_num_folded_variables() const {
+    return variables_by_folded_variable.size();
+}
+
+int LPFolding::get_num_constraints() const {
+    return folded_constraint_by_constraint.size();
+}
+
+int LPFolding::get_folded_variable(int variable_id) const {
+    return folded_variable_by_variable[variable_id];
+}
+
+int LPFolding::get_folded_constraint(int constraint_id) const {
+    return folded_constraint_by_constraint[constraint_id];
+}
+
+double LPFolding::set_objective_coefficient(
+    int variable_id, double coefficient) {
+    objective_coefficients[variable_id] = coefficient;
+    double folded_coefficient = 0;
+    int folded_id = folded_variable_by_variable[variable_id];
+    for (int var : variables_by_folded_variable[folded_id]) {
+        folded_coefficient += objective_coefficients[var];
+    }
+    return folded_coefficient;
+}
+
+double LPFolding::set_variable_lower_bound(int variable_id, double bound) {
+    variable_lower_bounds[variable_id] = bound;
+    return get_folded_variable_lower_bound(
+        folded_variable_by_variable[variable_id]);
+}
+
+double LPFolding::set_variable_upper_bound(int variable_id, double bound) {
+    variable_upper_bounds[variable_id] = bound;
+    return get_folded_variable_upper_bound(
+        folded_variable_by_variable[variable_id]);
+}
+
+double LPFolding::set_constraint_lower_bound(int constraint_id, double bound) {
+    remove_constraint_bounds(constraint_id);
+    constraint_lower_bounds[constraint_id] = bound;
+    add_constraint_bounds(constraint_id);
+    return get_folded_constraint_lower_bound(
+        folded_constraint_by_constraint[constraint_id]);
+}
+
+double LPFolding::set_constraint_upper_bound(int constraint_id, double bound) {
+    remove_constraint_bounds(constraint_id);
+    constraint_upper_bounds[constraint_id] = bound;
+    add_constraint_bounds(constraint_id);
+    return get_folded_constraint_upper_bound(
+        folded_constraint_by_constraint[constraint_id]);
+}
+
+vector<double> LPFolding::fold_objective(const vector<double> &coefficients) {
+    assert(coefficients.size() == objective_coefficients.size());
+    objective_coefficients = coefficients;
+    vector<double> folded_coefficients(get_num_folded_variables(), 0);
+    for (size_t var = 0; var < coefficients.size(); ++var) {
+        folded_coefficients[folded_variable_by_variable[var]] +=
+            coefficients[var];
+    }
+    return folded_coefficients;
+}
+
+vector<double> LPFolding::unfold_solution(
+    const vector<double> &folded_solution) const {
+    assert(static_cast<int>(folded_solution.size()) ==
+           get_num_folded_variables());
+    vector<double> solution;
+    solution.reserve(folded_variable_by_variable.size());
+    for (int folded_id : folded_variable_by_variable) {
+        solution.push_back(folded_solution[folded_id]);
+    }
+    return solution;
+}
+
+void LPFolding::print_statistics(utils::LogProxy &log) const {
+    if (log.is_at_least_normal()) {
+        log << "LP symmetries used for folding: " << num_symmetries << endl;
+        log << "Folded LP variables: " << get_num_folded_variables() << "/"
+            << get_num_variables() << endl;
+        log << "Folded LP constraints: " << num_folded_constraints << "/"
+            << get_num_constraints() << endl;
+    }
+}
+}
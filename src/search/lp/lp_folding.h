@@ -0,0 +1,106 @@
+#ifndef LP_LP_FOLDING_H
+#define LP_LP_FOLDING_H
+
+#include <vector>
+
+namespace utils {
+class LogProxy;
+}
+
+namespace lp {
+class LinearProgram;
+
+/*
+  Fold a linear program by symmetries of its variables.
+
+  We are given permutations of the LP variables and only keep those that
+  are symmetries of the LP: they map every variable onto a variable with
+  the same bounds, objective coefficient and integrality, and every
+  constraint onto a constraint with the same bounds and the mapped
+  coefficients. The folded LP has one variable for each orbit of
+  variables under these symmetries, standing for all variables of the
+  orbit, and one constraint for each orbit of constraints, which is the
+  sum of the constraints in the orbit.
+
+  Solutions of the folded LP correspond to the solutions of the original
+  LP that assign the same value to all variables of an orbit. If the
+  objective is invariant under the symmetries, averaging any solution
+  over the group shows that such a solution is among the optimal ones, so
+  folding preserves the optimal objective value.
+
+  Bounds and objective coefficients of the original LP can be changed
+  after folding. Constraint bounds and objective coefficients are summed
+  over their orbit, and variable bounds are averaged over their orbit. If
+  symmetric constraints or variables get different bounds (e.g., bounds
+  that depend on a state), the folded LP is a relaxation of the LP
+  restricted to symmetric solutions: averaging a solution of the original
+  LP over the group keeps the summed constraints satisfied and yields
+  values between the averaged variable bounds. Hence, as long as the
+  objective is invariant, the optimal value of the folded LP is bounded by
+  the optimal value of the original LP (from below for minimization and
+  from above for maximization). Folding MIPs is not supported.
+*/
+class LPFolding {
+    double infinity;
+    int num_symmetries;
+
+    std::vector<int> folded_variable_by_variable;
+    std::vector<std::vector<int>> variables_by_folded_variable;
+    std::vector<int> folded_constraint_by_constraint;
+    int num_folded_constraints;
+
+    // Current bounds and objective coefficients of the original LP.
+    std::vector<double> variable_lower_bounds;
+    std::vector<double> variable_upper_bounds;
+    std::vector<double> objective_coefficients;
+    std::vector<double> constraint_lower_bounds;
+    std::vector<double> constraint_upper_bounds;
+
+    /*
+      Sums of the finite constraint bounds in each orbit of constraints and
+      number of infinite constraint bounds in each orbit.
+    */
+    std::vector<double> finite_lower_bound_sums;
+    std::vector<double> finite_upper_bound_sums;
+    std::vector<int> num_infinite_lower_bounds;
+    std::vector<int> num_infinite_upper_bounds;
+
+    bool is_infinite(double value) const;
+    double get_folded_variable_lower_bound(int folded_id) const;
+    double get_folded_variable_upper_bound(int folded_id) const;
+    double get_folded_constraint_lower_bound(int folded_id) const;
+    double get_folded_constraint_upper_bound(int folded_id) const;
+    void add_constraint_bounds(int constraint_id);
+    void remove_constraint_bounds(int constraint_id);
+public:
+    LPFolding(
+        const LinearProgram &lp,
+        const std::vector<std::vector<int>> &variable_permutations);
+
+    LinearProgram create_folded_lp(const LinearProgram &lp) const;
+
+    int get_num_variables() const;
+    int get_num_folded_variables() const;
+    int get_num_constraints() const;
+    int get_folded_variable(int variable_id) const;
+    int get_folded_constraint(int constraint_id) const;
+
+    /*
+      The following methods update the original LP and return the new
+      coefficient or bound of the folded variable or constraint.
+    */
+    double set_objective_coefficient(int variable_id, double coefficient);
+    double set_variable_lower_bound(int variable_id, double bound);
+    double set_variable_upper_bound(int variable_id, double bound);
+    double set_constraint_lower_bound(int constraint_id, double bound);
+    double set_constraint_upper_bound(int constraint_id, double bound);
+
+    std::vector<double> fold_objective(const std::vector<double> &coefficients);
+    std::vector<double> unfold_solution(
+        const std::vector<double> &folded_solution) const;
+
+    void print_statistics(utils::LogProxy &log) const;
+};
+}
+
+#endif
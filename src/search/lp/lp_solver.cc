@@ -170,6 +170,7 @@ void LPSolver::clear_temporary_data() {
 
 void LPSolver::load_problem(const LinearProgram &lp) {
     clear_temporary_data();
+    folding = nullptr;
     is_mip = false;
     is_initialized = false;
     num_permanent_constraints = lp.get_constraints().size();
@@ -269,8 +270,19 @@ void LPSolver::load_problem(const LinearProgram &lp) {
     clear_temporary_data();
 }
 
+void LPSolver::load_folded_problem(
+    const LinearProgram &lp, unique_ptr<LPFolding> &&folding) {
+    load_problem(folding->create_folded_lp(lp));
+    this->folding = move(folding);
+}
+
 void LPSolver::add_temporary_constraints(const vector<LPConstraint> &constraints) {
     if (!constraints.empty()) {
+        if (folding) {
+            cerr << "Temporary constraints are not supported for folded LPs."
+                 << endl;
+            utils::exit_with(ExitCode::SEARCH_UNSUPPORTED);
+        }
         clear_temporary_data();
         int num_rows = constraints.size();
         for (const LPConstraint &constraint : constraints) {
@@ -320,12 +332,18 @@ double LPSolver::get_infinity() const {
 
 void LPSolver::set_objective_coefficients(const vector<double> &coefficients) {
     assert(static_cast<int>(coefficients.size()) == get_num_variables());
-    vector<int> indices(coefficients.size());
+    const vector<double> *objective_coefficients = &coefficients;
+    vector<double> folded_coefficients;
+    if (folding) {
+        folded_coefficients = folding->fold_objective(coefficients);
+        objective_coefficients = &folded_coefficients;
+    }
+    vector<int> indices(objective_coefficients->size());
     iota(indices.begin(), indices.end(), 0);
     try {
         lp_solver->setObjCoeffSet(indices.data(),
                                   indices.data() + indices.size(),
-                                  coefficients.data());
+                                  objective_coefficients->data());
     } catch (CoinError &error) {
         handle_coin_error(error);
     }
@@ -334,6 +352,10 @@ void LPSolver::set_objective_coefficients(const vector<double> &coefficients) {
 
 void LPSolver::set_objective_coefficient(int index, double coefficient) {
     assert(index < get_num_variables());
+    if (folding) {
+        coefficient = folding->set_objective_coefficient(index, coefficient);
+        index = folding->get_folded_variable(index);
+    }
     try {
         lp_solver->setObjCoeff(index, coefficient);
     } catch (CoinError &error) {
@@ -344,6 +366,10 @@ void LPSolver::set_objective_coefficient(int index, double coefficient) {
 
 void LPSolver::set_constraint_lower_bound(int index, double bound) {
     assert(index < get_num_constraints());
+    if (folding) {
+        bound = folding->set_constraint_lower_bound(index, bound);
+        index = folding->get_folded_constraint(index);
+    }
     try {
         lp_solver->setRowLower(index, bound);
     } catch (CoinError &error) {
@@ -354,6 +380,10 @@ void LPSolver::set_constraint_lower_bound(int index, double bound) {
 
 void LPSolver::set_constraint_upper_bound(int index, double bound) {
     assert(index < get_num_constraints());
+    if (folding) {
+        bound = folding->set_constraint_upper_bound(index, bound);
+        index = folding->get_folded_constraint(index);
+    }
     try {
         lp_solver->setRowUpper(index, bound);
     } catch (CoinError &error) {
@@ -364,6 +394,10 @@ void LPSolver::set_constraint_upper_bound(int index, double bound) {
 
 void LPSolver::set_variable_lower_bound(int index, double bound) {
     assert(index < get_num_variables());
+    if (folding) {
+        bound = folding->set_variable_lower_bound(index, bound);
+        index = folding->get_folded_variable(index);
+    }
     try {
         lp_solver->setColLower(index, bound);
     } catch (CoinError &error) {
@@ -374,6 +408,10 @@ void LPSolver::set_variable_lower_bound(int index, double bound) {
 
 void LPSolver::set_variable_upper_bound(int index, double bound) {
     assert(index < get_num_variables());
+    if (folding) {
+        bound = folding->set_variable_upper_bound(index, bound);
+        index = folding->get_folded_variable(index);
+    }
     try {
         lp_solver->setColUpper(index, bound);
     } catch (CoinError &error) {
@@ -473,13 +511,20 @@ vector<double> LPSolver::extract_solution() const {
     assert(has_optimal_solution());
     try {
         const double *sol = lp_solver->getColSolution();
-        return vector<double>(sol, sol + get_num_variables());
+        vector<double> solution(sol, sol + lp_solver->getNumCols());
+        if (folding) {
+            return folding->unfold_solution(solution);
+        }
+        return solution;
     } catch (CoinError &error) {
         handle_coin_error(error);
     }
 }
 
 int LPSolver::get_num_variables() const {
+    if (folding) {
+        return folding->get_num_variables();
+    }
     try {
         return lp_solver->getNumCols();
     } catch (CoinError &error) {
@@ -488,6 +533,9 @@ int LPSolver::get_num_variables() const {
 }
 
 int LPSolver::get_num_constraints() const {
+    if (folding) {
+        return folding->get_num_constraints();
+    }
     try {
         return lp_solver->getNumRows();
     } catch (CoinError &error) {
@@ -1,6 +1,8 @@
 #ifndef LP_LP_SOLVER_H
 #define LP_LP_SOLVER_H
 
+#include "lp_folding.h"
+
 #include "../algorithms/named_vector.h"
 #include "../utils/language.h"
 #include "../utils/system.h"
@@ -125,6 +127,12 @@ class LPSolver {
 #ifdef USE_LP
     std::unique_ptr<OsiSolverInterface> lp_solver;
 #endif
+    /*
+      If the loaded problem is folded, the solver works on the folded LP and
+      all methods translate between variables and constraints of the
+      original LP and the folded LP.
+    */
+    std::unique_ptr<LPFolding> folding;
 
     /*
       Temporary data for assigning a new problem. We keep the vectors
@@ -151,6 +159,12 @@ public:
     ~LPSolver();
 
     LP_METHOD(void load_problem(const LinearProgram &lp))
+    /*
+      Load the given LP folded by the given folding (see lp_folding.h).
+      Temporary constraints are not supported for folded problems.
+    */
+    LP_METHOD(void load_folded_problem(
+                  const LinearProgram &lp, std::unique_ptr<LPFolding> &&folding))
     LP_METHOD(void add_temporary_constraints(const std::vector<LPConstraint> &constraints))
     LP_METHOD(void clear_temporary_constraints())
     LP_METHOD(double get_infinity() const)
@@ -2,6 +2,7 @@
 #define OPEN_LIST_H
 
 #include <set>
+#include <vector>
 
 #include "evaluation_context.h"
 #include "operator_id.h"
@@ -90,6 +91,19 @@ public:
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) = 0;
 
+    /*
+      Compute the values of the evaluators used by the open list for a
+      batch of evaluation contexts, e.g., for all successors of an
+      expanded state, so that heuristics can evaluate them together. The
+      values are cached in the contexts for subsequent calls to insert
+      and is_dead_end.
+
+      The default implementation does nothing, so the values are
+      computed one context at a time when they are needed.
+    */
+    virtual void evaluate_batch(
+        const std::vector<EvaluationContext *> &eval_contexts);
+
     /*
       Accessor method for only_preferred.
 
@@ -142,6 +156,11 @@ template<class Entry>
 void OpenList<Entry>::boost_preferred() {
 }
 
+template<class Entry>
+void OpenList<Entry>::evaluate_batch(
+    const std::vector<EvaluationContext *> &) {
+}
+
 template<class Entry>
 void OpenList<Entry>::insert(
     EvaluationContext &eval_context, const Entry &entry) {
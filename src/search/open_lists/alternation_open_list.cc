@@ -7,6 +7,7 @@
 #include "../utils/memory.h"
 #include "../utils/system.h"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <vector>
@@ -35,6 +36,8 @@ public:
     virtual void boost_preferred() override;
     virtual void get_path_dependent_evaluators(
         set<Evaluator *> &evals) override;
+    virtual void evaluate_batch(
+        const vector<EvaluationContext *> &eval_contexts) override;
     virtual bool is_dead_end(
         EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
@@ -105,6 +108,26 @@ void AlternationOpenList<Entry>::get_path_dependent_evaluators(
         sublist->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void AlternationOpenList<Entry>::evaluate_batch(
+    const vector<EvaluationContext *> &eval_contexts) {
+    /*
+      Like is_reliable_dead_end, we do not evaluate the remaining sublists
+      for states that a sublist reliably detects as dead ends.
+    */
+    vector<EvaluationContext *> remaining_eval_contexts = eval_contexts;
+    for (const auto &sublist : open_lists) {
+        sublist->evaluate_batch(remaining_eval_contexts);
+        remaining_eval_contexts.erase(
+            remove_if(remaining_eval_contexts.begin(),
+                      remaining_eval_contexts.end(),
+                      [&](EvaluationContext *eval_context) {
+                          return sublist->is_reliable_dead_end(*eval_context);
+                      }),
+            remaining_eval_contexts.end());
+    }
+}
+
 template<class Entry>
 bool AlternationOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
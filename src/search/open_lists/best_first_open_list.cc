@@ -36,6 +36,8 @@ public:
     virtual bool empty() const override;
     virtual void clear() override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void evaluate_batch(
+        const vector<EvaluationContext *> &eval_contexts) override;
     virtual bool is_dead_end(
         EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
@@ -98,6 +100,12 @@ void BestFirstOpenList<Entry>::get_path_dependent_evaluators(
     evaluator->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void BestFirstOpenList<Entry>::evaluate_batch(
+    const vector<EvaluationContext *> &eval_contexts) {
+    EvaluationContext::evaluate_batch(eval_contexts, evaluator.get());
+}
+
 template<class Entry>
 bool BestFirstOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
@@ -7,6 +7,7 @@
 
 #include "../utils/memory.h"
 
+#include <algorithm>
 #include <cassert>
 #include <deque>
 #include <map>
@@ -45,6 +46,8 @@ public:
     virtual bool empty() const override;
     virtual void clear() override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void evaluate_batch(
+        const vector<EvaluationContext *> &eval_contexts) override;
     virtual bool is_dead_end(
         EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
@@ -109,6 +112,30 @@ void TieBreakingOpenList<Entry>::get_path_dependent_evaluators(
         evaluator->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void TieBreakingOpenList<Entry>::evaluate_batch(
+    const vector<EvaluationContext *> &eval_contexts) {
+    /*
+      Like is_reliable_dead_end, we do not evaluate the remaining
+      evaluators for states that an evaluator reliably detects as dead ends.
+    */
+    vector<EvaluationContext *> remaining_eval_contexts = eval_contexts;
+    for (const shared_ptr<Evaluator> &evaluator : evaluators) {
+        EvaluationContext::evaluate_batch(
+            remaining_eval_contexts, evaluator.get());
+        if (evaluator->dead_ends_are_reliable()) {
+            remaining_eval_contexts.erase(
+                remove_if(remaining_eval_contexts.begin(),
+                          remaining_eval_contexts.end(),
+                          [&](EvaluationContext *eval_context) {
+                              return eval_context->is_evaluator_value_infinite(
+                                  evaluator.get());
+                          }),
+                remaining_eval_contexts.end());
+        }
+    }
+}
+
 template<class Entry>
 bool TieBreakingOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
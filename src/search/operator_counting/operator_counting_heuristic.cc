@@ -5,9 +5,17 @@
 #include "../option_parser.h"
 #include "../plugin.h"
 
+#include "../lp/lp_folding.h"
+#include "../structural_symmetries/group.h"
+#include "../structural_symmetries/operator_mapper.h"
+#include "../tasks/root_task.h"
+#include "../utils/logging.h"
 #include "../utils/markup.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
 
 #include <cmath>
+#include <numeric>
 
 using namespace std;
 
@@ -29,12 +37,59 @@ OperatorCountingHeuristic::OperatorCountingHeuristic(const Options &opts)
     for (const auto &generator : constraint_generators) {
         generator->initialize_constraints(task, lp);
     }
-    lp_solver.load_problem(lp);
+    shared_ptr<Group> symmetries =
+        opts.get<shared_ptr<Group>>("symmetries", nullptr);
+    if (symmetries) {
+        lp_solver.load_folded_problem(lp, create_lp_folding(lp, *symmetries));
+    } else {
+        lp_solver.load_problem(lp);
+    }
 }
 
 OperatorCountingHeuristic::~OperatorCountingHeuristic() {
 }
 
+unique_ptr<lp::LPFolding> OperatorCountingHeuristic::create_lp_folding(
+    const lp::LinearProgram &lp, Group &symmetries) {
+    if (!symmetries.is_initialized()) {
+        log << "Initializing symmetries (operator counting)" << endl;
+        symmetries.compute_symmetries(TaskProxy(*tasks::g_root_task));
+    }
+    if (symmetries.has_symmetries() &&
+        symmetries.get_permutation_num_variables() !=
+        static_cast<int>(task_proxy.get_variables().size())) {
+        cerr << "Folding operator-counting LPs requires the variables of the "
+             << "root task." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+
+    /*
+      Permute the operator-counting variables by the operator mappings of
+      the generators. Constraint generators may add further variables,
+      which we leave in place. The folding only uses permutations that are
+      symmetries of the LP, so it discards generators under which such
+      variables would have to be permuted as well.
+    */
+    int num_ops = task_proxy.get_operators().size();
+    int num_variables = lp.get_variables().size();
+    OperatorMapper operator_mapper(task_proxy);
+    vector<vector<int>> variable_permutations;
+    for (int gen = 0; gen < symmetries.get_num_generators(); ++gen) {
+        vector<int> permutation = operator_mapper.compute_operator_mapping(
+            symmetries.get_permutation(gen));
+        if (static_cast<int>(permutation.size()) != num_ops) {
+            continue;
+        }
+        permutation.resize(num_variables);
+        iota(permutation.begin() + num_ops, permutation.end(), num_ops);
+        variable_permutations.push_back(move(permutation));
+    }
+    unique_ptr<lp::LPFolding> folding =
+        utils::make_unique_ptr<lp::LPFolding>(lp, variable_permutations);
+    folding->print_statistics(log);
+    return folding;
+}
+
 int OperatorCountingHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     assert(!lp_solver.has_temporary_constraints());
@@ -109,6 +164,17 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "computationally expensive. Turning this option on can thus drastically "
         "increase the runtime.",
         "false");
+    parser.add_option<shared_ptr<Group>>(
+        "symmetries",
+        "symmetries object to compute structural symmetries; if given, the "
+        "LP is folded by the symmetries of the task that are symmetries of "
+        "the LP: symmetric operator-counting variables are merged into one "
+        "variable and symmetric constraints are summed. The folded LP is a "
+        "relaxation of the original LP, so the heuristic stays admissible "
+        "but can be less informed. Folding is not supported together with "
+        "integer operator counts or constraint generators that add "
+        "constraints in each state (such as lmcut_constraints).",
+        OptionParser::NONE);
 
     lp::add_lp_solver_option_to_parser(parser);
     Heuristic::add_options_to_parser(parser);
@@ -117,6 +183,11 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         return nullptr;
     opts.verify_list_non_empty<shared_ptr<ConstraintGenerator>>(
         "constraint_generators");
+    if (opts.contains("symmetries") &&
+        opts.get<bool>("use_integer_operator_counts")) {
+        parser.error("folding LPs by symmetries is not supported for integer "
+                     "operator counts");
+    }
     if (parser.dry_run())
         return nullptr;
     return make_shared<OperatorCountingHeuristic>(opts);
@@ -8,6 +8,8 @@
 #include <memory>
 #include <vector>
 
+class Group;
+
 namespace options {
 class Options;
 }
@@ -19,6 +21,9 @@ class OperatorCountingHeuristic : public Heuristic {
     std::vector<std::shared_ptr<ConstraintGenerator>> constraint_generators;
     lp::LPSolver lp_solver;
     const bool use_integer_operator_counts;
+
+    std::unique_ptr<lp::LPFolding> create_lp_folding(
+        const lp::LinearProgram &lp, Group &symmetries);
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
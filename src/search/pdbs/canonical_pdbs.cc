@@ -1,6 +1,7 @@
 #include "canonical_pdbs.h"
 
 #include "pattern_database.h"
+#include "symmetric_lookups.h"
 
 #include <algorithm>
 #include <cassert>
@@ -12,8 +13,11 @@ using namespace std;
 namespace pdbs {
 CanonicalPDBs::CanonicalPDBs(
     const shared_ptr<PDBCollection> &pdbs,
-    const shared_ptr<vector<PatternClique>> &pattern_cliques)
-    : pdbs(pdbs), pattern_cliques(pattern_cliques) {
+    const shared_ptr<vector<PatternClique>> &pattern_cliques,
+    const shared_ptr<SymmetricLookups> &symmetric_lookups)
+    : pdbs(pdbs),
+      pattern_cliques(pattern_cliques),
+      symmetric_lookups(symmetric_lookups) {
     assert(pdbs);
     assert(pattern_cliques);
 }
@@ -21,6 +25,9 @@ CanonicalPDBs::CanonicalPDBs(
 int CanonicalPDBs::get_value(const State &state) const {
     // If we have an empty collection, then pattern_cliques = { \emptyset }.
     assert(!pattern_cliques->empty());
+    if (symmetric_lookups) {
+        return get_value_with_symmetric_lookups(state);
+    }
     int max_h = 0;
     vector<int> h_values;
     h_values.reserve(pdbs->size());
@@ -41,4 +48,41 @@ int CanonicalPDBs::get_value(const State &state) const {
     }
     return max_h;
 }
+
+int CanonicalPDBs::get_value_with_symmetric_lookups(const State &state) const {
+    int num_lookups = symmetric_lookups->get_num_lookups();
+    int num_pdbs = pdbs->size();
+    /*
+      h_values[k * num_pdbs + i] is the value of the k-th symmetric image of
+      the state in the i-th PDB. We compute the hash indices of all images
+      for one PDB at a time.
+    */
+    vector<int> h_values(num_lookups * num_pdbs);
+    vector<int> hash_indices;
+    state.unpack();
+    for (int i = 0; i < num_pdbs; ++i) {
+        const PatternDatabase &pdb = *(*pdbs)[i];
+        symmetric_lookups->compute_hash_indices(
+            i, state.get_unpacked_values(), hash_indices);
+        for (int k = 0; k < num_lookups; ++k) {
+            int h = pdb.get_value_for_hash_index(hash_indices[k]);
+            if (h == numeric_limits<int>::max()) {
+                return numeric_limits<int>::max();
+            }
+            h_values[k * num_pdbs + i] = h;
+        }
+    }
+    int max_h = 0;
+    for (int k = 0; k < num_lookups; ++k) {
+        const int *image_h_values = &h_values[k * num_pdbs];
+        for (const PatternClique &clique : *pattern_cliques) {
+            int clique_h = 0;
+            for (PatternID pdb_index : clique) {
+                clique_h += image_h_values[pdb_index];
+            }
+            max_h = max(max_h, clique_h);
+        }
+    }
+    return max_h;
+}
 }
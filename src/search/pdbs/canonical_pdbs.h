@@ -8,14 +8,20 @@
 class State;
 
 namespace pdbs {
+class SymmetricLookups;
+
 class CanonicalPDBs {
     std::shared_ptr<PDBCollection> pdbs;
     std::shared_ptr<std::vector<PatternClique>> pattern_cliques;
+    // If given, maximize over the symmetric images of the state.
+    std::shared_ptr<SymmetricLookups> symmetric_lookups;
 
+    int get_value_with_symmetric_lookups(const State &state) const;
 public:
     CanonicalPDBs(
         const std::shared_ptr<PDBCollection> &pdbs,
-        const std::shared_ptr<std::vector<PatternClique>> &pattern_cliques);
+        const std::shared_ptr<std::vector<PatternClique>> &pattern_cliques,
+        const std::shared_ptr<SymmetricLookups> &symmetric_lookups = nullptr);
     ~CanonicalPDBs() = default;
 
     int get_value(const State &state) const;
@@ -2,6 +2,7 @@
 
 #include "dominance_pruning.h"
 #include "pattern_generator.h"
+#include "symmetric_lookups.h"
 #include "utils.h"
 
 #include "../option_parser.h"
@@ -61,7 +62,9 @@ CanonicalPDBs get_canonical_pdbs_from_options(
 
     dump_pattern_collection_generation_statistics(
         "Canonical PDB heuristic", timer(), pattern_collection_info, log);
-    return CanonicalPDBs(pdbs, pattern_cliques);
+    shared_ptr<SymmetricLookups> symmetric_lookups =
+        get_symmetric_lookups_from_options(opts, task, *pdbs, log);
+    return CanonicalPDBs(pdbs, pattern_cliques, symmetric_lookups);
 }
 
 CanonicalPDBsHeuristic::CanonicalPDBsHeuristic(const Options &opts)
@@ -113,6 +116,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "systematic(1)");
 
     add_canonical_pdbs_options_to_parser(parser);
+    add_symmetric_lookups_options_to_parser(parser);
 
     Heuristic::add_options_to_parser(parser);
 
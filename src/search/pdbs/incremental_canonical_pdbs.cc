@@ -2,6 +2,7 @@
 
 #include "canonical_pdbs.h"
 #include "pattern_database.h"
+#include "symmetric_pdb_factory.h"
 
 #include <limits>
 
@@ -9,8 +10,10 @@ using namespace std;
 
 namespace pdbs {
 IncrementalCanonicalPDBs::IncrementalCanonicalPDBs(
-    const TaskProxy &task_proxy, const PatternCollection &intitial_patterns)
+    const TaskProxy &task_proxy, const PatternCollection &intitial_patterns,
+    const shared_ptr<SymmetricPDBFactory> &symmetric_pdb_factory)
     : task_proxy(task_proxy),
+      symmetric_pdb_factory(symmetric_pdb_factory),
       patterns(make_shared<PatternCollection>(intitial_patterns.begin(),
                                               intitial_patterns.end())),
       pattern_databases(make_shared<PDBCollection>()),
@@ -24,7 +27,12 @@ IncrementalCanonicalPDBs::IncrementalCanonicalPDBs(
 }
 
 void IncrementalCanonicalPDBs::add_pdb_for_pattern(const Pattern &pattern) {
-    pattern_databases->push_back(make_shared<PatternDatabase>(task_proxy, pattern));
+    if (symmetric_pdb_factory) {
+        pattern_databases->push_back(
+            symmetric_pdb_factory->create_pdb(task_proxy, pattern));
+    } else {
+        pattern_databases->push_back(make_shared<PatternDatabase>(task_proxy, pattern));
+    }
     size += pattern_databases->back()->get_size();
 }
 
@@ -10,8 +10,12 @@
 #include <memory>
 
 namespace pdbs {
+class SymmetricPDBFactory;
+
 class IncrementalCanonicalPDBs {
     TaskProxy task_proxy;
+    // If given, used to derive symmetric PDBs for the initial patterns.
+    std::shared_ptr<SymmetricPDBFactory> symmetric_pdb_factory;
 
     std::shared_ptr<PatternCollection> patterns;
     std::shared_ptr<PDBCollection> pattern_databases;
@@ -28,8 +32,10 @@ class IncrementalCanonicalPDBs {
 
     void recompute_pattern_cliques();
 public:
-    IncrementalCanonicalPDBs(const TaskProxy &task_proxy,
-                             const PatternCollection &intitial_patterns);
+    IncrementalCanonicalPDBs(
+        const TaskProxy &task_proxy,
+        const PatternCollection &intitial_patterns,
+        const std::shared_ptr<SymmetricPDBFactory> &symmetric_pdb_factory = nullptr);
     virtual ~IncrementalCanonicalPDBs() = default;
 
     // Adds a new PDB to the collection and recomputes pattern_cliques.
@@ -3,6 +3,7 @@
 #include "canonical_pdbs_heuristic.h"
 #include "incremental_canonical_pdbs.h"
 #include "pattern_database.h"
+#include "symmetric_pdb_factory.h"
 #include "utils.h"
 #include "validation.h"
 
@@ -121,7 +122,10 @@ PatternCollectionGeneratorHillclimbing::PatternCollectionGeneratorHillclimbing(c
       min_improvement(opts.get<int>("min_improvement")),
       max_time(opts.get<double>("max_time")),
       rng(utils::parse_rng_from_options(opts)),
+      prune_symmetric_candidates(
+          symmetric_pdb_factory && opts.get<bool>("prune_symmetric_candidates")),
       num_rejected(0),
+      num_symmetric_candidates(0),
       hill_climbing_timer(0) {
 }
 
@@ -160,8 +164,24 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
                       surpass the size limit.
                     */
                     generated_patterns.insert(new_pattern);
-                    candidate_pdbs.push_back(
-                        make_shared<PatternDatabase>(task_proxy, new_pattern));
+                    if (prune_symmetric_candidates) {
+                        PatternCollection orbit =
+                            symmetric_pdb_factory->compute_pattern_orbit(new_pattern);
+                        orbit.erase(orbit.begin());
+                        for (const Pattern &symmetric_pattern : orbit) {
+                            generated_patterns.insert(symmetric_pattern);
+                        }
+                        num_symmetric_candidates += orbit.size();
+                        symmetric_candidate_patterns[new_pattern] = move(orbit);
+                    }
+                    if (symmetric_pdb_factory) {
+                        candidate_pdbs.push_back(
+                            symmetric_pdb_factory->create_pdb(
+                                task_proxy, new_pattern));
+                    } else {
+                        candidate_pdbs.push_back(
+                            make_shared<PatternDatabase>(task_proxy, new_pattern));
+                    }
                     max_pdb_size = max(max_pdb_size,
                                        candidate_pdbs.back()->get_size());
                 }
@@ -219,10 +239,18 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
         }
         /*
           If a candidate's size added to the current collection's size exceeds
-          the maximum collection size, then forget the pdb.
+          the maximum collection size, then forget the pdb. When pruning
+          symmetric candidates, the whole orbit of the candidate is added.
         */
-        int combined_size = current_pdbs->get_size() + pdb->get_size();
-        if (combined_size > collection_max_size) {
+        int num_symmetric_pdbs = 1;
+        if (prune_symmetric_candidates) {
+            num_symmetric_pdbs +=
+                symmetric_candidate_patterns[pdb->get_pattern()].size();
+        }
+        int remaining_size = collection_max_size - current_pdbs->get_size();
+        if (remaining_size < 0 ||
+            !utils::is_product_within_limit(
+                pdb->get_size(), num_symmetric_pdbs, remaining_size)) {
             candidate_pdbs[i] = nullptr;
             continue;
         }
@@ -397,6 +425,19 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
             }
             current_pdbs->add_pdb(best_pdb);
 
+            /*
+              Add the PDBs for the rest of the orbit. Their candidates are
+              symmetric to the candidates of best_pdb, so we do not need to
+              generate them.
+            */
+            if (prune_symmetric_candidates) {
+                for (const Pattern &symmetric_pattern :
+                     symmetric_candidate_patterns[best_pattern]) {
+                    current_pdbs->add_pdb(symmetric_pdb_factory->create_pdb(
+                                              task_proxy, symmetric_pattern));
+                }
+            }
+
             // Generate candidate patterns and PDBs for next iteration.
             int new_max_pdb_size = generate_candidate_pdbs(
                 task_proxy, relevant_neighbours, *best_pdb, generated_patterns,
@@ -422,10 +463,17 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
         log << "Hill climbing iterations: " << num_iterations << endl;
         log << "Hill climbing generated patterns: " << generated_patterns.size() << endl;
         log << "Hill climbing rejected patterns: " << num_rejected << endl;
+        if (prune_symmetric_candidates) {
+            log << "Hill climbing pruned symmetric patterns: "
+                << num_symmetric_candidates << endl;
+        }
         log << "Hill climbing maximum PDB size: " << max_pdb_size << endl;
         log << "Hill climbing time: "
             << hill_climbing_timer->get_elapsed_time() << endl;
     }
+    if (symmetric_pdb_factory) {
+        symmetric_pdb_factory->print_statistics(log);
+    }
 
     delete hill_climbing_timer;
     hill_climbing_timer = nullptr;
@@ -447,7 +495,7 @@ PatternCollectionInformation PatternCollectionGeneratorHillclimbing::compute_pat
         initial_pattern_collection.emplace_back(1, goal_var_id);
     }
     current_pdbs = utils::make_unique_ptr<IncrementalCanonicalPDBs>(
-        task_proxy, initial_pattern_collection);
+        task_proxy, initial_pattern_collection, symmetric_pdb_factory);
     if (log.is_at_least_normal()) {
         log << "Done calculating initial pattern collection: " << timer << endl;
     }
@@ -553,6 +601,13 @@ void add_hillclimbing_options(OptionParser &parser) {
         "infinity",
         Bounds("0.0", "infinity"));
     utils::add_rng_options(parser);
+    add_symmetric_pdb_factory_options_to_parser(parser);
+    parser.add_option<bool>(
+        "prune_symmetric_candidates",
+        "if symmetries are given, only evaluate one candidate pattern per "
+        "orbit of symmetric candidate patterns and add the whole orbit to "
+        "the collection if the candidate is selected",
+        "true");
     add_generator_options_to_parser(parser);
 }
 
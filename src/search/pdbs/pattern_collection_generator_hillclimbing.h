@@ -6,6 +6,8 @@
 
 #include "../task_proxy.h"
 
+#include "../utils/hash.h"
+
 #include <cstdlib>
 #include <memory>
 #include <set>
@@ -36,11 +38,26 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
     const int min_improvement;
     const double max_time;
     std::shared_ptr<utils::RandomNumberGenerator> rng;
+    /*
+      If true (and symmetries are given), only one candidate pattern per
+      orbit is evaluated, and the whole orbit is added if it is selected.
+      Since the initial collection is closed under the symmetries, this
+      keeps the collection closed under the symmetries, so all candidates in
+      an orbit improve the collection equally.
+    */
+    const bool prune_symmetric_candidates;
 
     std::unique_ptr<IncrementalCanonicalPDBs> current_pdbs;
 
+    /*
+      Maps the pattern of each evaluated candidate PDB to the other patterns
+      in its orbit when pruning symmetric candidates.
+    */
+    utils::HashMap<Pattern, PatternCollection> symmetric_candidate_patterns;
+
     // for stats only
     int num_rejected;
+    int num_symmetric_candidates;
     utils::CountdownTimer *hill_climbing_timer;
 
     /*
@@ -48,7 +65,9 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
       relevant variable are considered as candidate patterns. If the candidate
       pattern has not been previously considered (not contained in
       generated_patterns) and if building a PDB for it does not surpass the
-      size limit, then the PDB is built and added to candidate_pdbs.
+      size limit, then the PDB is built and added to candidate_pdbs. When
+      pruning symmetric candidates, the other patterns in the orbit of the
+      candidate pattern are added to generated_patterns instead.
 
       The method returns the size of the largest PDB added to candidate_pdbs.
     */
@@ -77,7 +96,8 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
     /*
       Searches for the best improving pdb in candidate_pdbs according to the
       counting approximation and the given samples. Returns the improvement and
-      the index of the best pdb in candidate_pdbs.
+      the index of the best pdb in candidate_pdbs. When pruning symmetric
+      candidates, the size limit applies to the PDBs of the whole orbit.
     */
     std::pair<int, int> find_best_improving_pdb(
         const std::vector<State> &samples,
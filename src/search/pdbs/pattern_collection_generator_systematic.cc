@@ -1,5 +1,6 @@
 #include "pattern_collection_generator_systematic.h"
 
+#include "symmetric_pdb_factory.h"
 #include "utils.h"
 #include "validation.h"
 
@@ -310,6 +311,7 @@ static shared_ptr<PatternCollectionGenerator> _parse(OptionParser &parser) {
         "Only consider the union of two disjoint patterns if the union has "
         "more information than the individual patterns.",
         "true");
+    add_symmetric_pdb_factory_options_to_parser(parser);
     add_generator_options_to_parser(parser);
 
     Options opts = parser.parse();
@@ -2,6 +2,7 @@
 
 #include "pattern_database.h"
 #include "pattern_cliques.h"
+#include "symmetric_pdb_factory.h"
 #include "validation.h"
 
 #include "../utils/logging.h"
@@ -23,6 +24,7 @@ PatternCollectionInformation::PatternCollectionInformation(
       patterns(patterns),
       pdbs(nullptr),
       pattern_cliques(nullptr),
+      symmetric_pdb_factory(nullptr),
       log(log) {
     assert(patterns);
     validate_and_normalize_patterns(task_proxy, *patterns, log);
@@ -64,7 +66,8 @@ void PatternCollectionInformation::create_pdbs_if_missing() {
         }
         pdbs = make_shared<PDBCollection>();
         for (const Pattern &pattern : *patterns) {
-            shared_ptr<PatternDatabase> pdb =
+            shared_ptr<PatternDatabase> pdb = symmetric_pdb_factory ?
+                symmetric_pdb_factory->create_pdb(task_proxy, pattern) :
                 make_shared<PatternDatabase>(task_proxy, pattern);
             pdbs->push_back(pdb);
         }
@@ -72,6 +75,9 @@ void PatternCollectionInformation::create_pdbs_if_missing() {
             log << "Done computing PDBs for pattern collection: "
                 << timer << endl;
         }
+        if (symmetric_pdb_factory) {
+            symmetric_pdb_factory->print_statistics(log);
+        }
     }
 }
 
@@ -101,6 +107,11 @@ void PatternCollectionInformation::set_pattern_cliques(
     assert(information_is_valid());
 }
 
+void PatternCollectionInformation::set_symmetric_pdb_factory(
+    const shared_ptr<SymmetricPDBFactory> &symmetric_pdb_factory_) {
+    symmetric_pdb_factory = symmetric_pdb_factory_;
+}
+
 shared_ptr<PatternCollection> PatternCollectionInformation::get_patterns() const {
     assert(patterns);
     return patterns;
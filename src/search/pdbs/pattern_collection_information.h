@@ -12,6 +12,8 @@ class LogProxy;
 }
 
 namespace pdbs {
+class SymmetricPDBFactory;
+
 /*
   This class contains everything we know about a pattern collection. It will
   always contain patterns, but can also contain the computed PDBs and maximal
@@ -29,6 +31,8 @@ class PatternCollectionInformation {
     std::shared_ptr<PatternCollection> patterns;
     std::shared_ptr<PDBCollection> pdbs;
     std::shared_ptr<std::vector<PatternClique>> pattern_cliques;
+    // If given, used to derive symmetric PDBs when creating the PDBs.
+    std::shared_ptr<SymmetricPDBFactory> symmetric_pdb_factory;
     utils::LogProxy &log;
 
     void create_pdbs_if_missing();
@@ -45,6 +49,8 @@ public:
     void set_pdbs(const std::shared_ptr<PDBCollection> &pdbs);
     void set_pattern_cliques(
         const std::shared_ptr<std::vector<PatternClique>> &pattern_cliques);
+    void set_symmetric_pdb_factory(
+        const std::shared_ptr<SymmetricPDBFactory> &symmetric_pdb_factory);
 
     TaskProxy get_task_proxy() const {
         return task_proxy;
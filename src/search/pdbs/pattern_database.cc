@@ -104,6 +104,33 @@ PatternDatabase::PatternDatabase(
     create_pdb(task_proxy, operator_costs, compute_plan, rng, compute_wildcard_plan);
 }
 
+PatternDatabase::PatternDatabase(
+    const shared_ptr<PatternDatabase> &pdb,
+    const vector<int> &image_vars,
+    const vector<vector<int>> &image_values)
+    : pattern(image_vars),
+      num_states(pdb->num_states),
+      source_pdb(pdb->source_pdb ? pdb->source_pdb : pdb) {
+    assert(image_vars.size() == pdb->pattern.size());
+    assert(image_values.size() == pdb->pattern.size());
+    sort(pattern.begin(), pattern.end());
+    assert(utils::is_sorted_unique(pattern));
+
+    value_offsets.reserve(pattern.size());
+    for (int var : pattern) {
+        int source_index = find(image_vars.begin(), image_vars.end(), var) -
+            image_vars.begin();
+        const vector<int> &values = image_values[source_index];
+        int offset = hash_contributions.size();
+        value_offsets.push_back(offset);
+        hash_contributions.resize(offset + values.size());
+        for (size_t value = 0; value < values.size(); ++value) {
+            hash_contributions[offset + values[value]] =
+                pdb->get_hash_contribution(source_index, value);
+        }
+    }
+}
+
 void PatternDatabase::multiply_out(
     int pos, int cost, vector<FactPair> &prev_pairs,
     vector<FactPair> &pre_pairs,
@@ -359,17 +386,50 @@ bool PatternDatabase::is_goal_state(
 
 int PatternDatabase::hash_index(const vector<int> &state) const {
     int index = 0;
-    for (size_t i = 0; i < pattern.size(); ++i) {
-        index += hash_multipliers[i] * state[pattern[i]];
+    if (hash_contributions.empty()) {
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            index += hash_multipliers[i] * state[pattern[i]];
+        }
+    } else {
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            index += hash_contributions[value_offsets[i] + state[pattern[i]]];
+        }
     }
     return index;
 }
 
 int PatternDatabase::get_value(const vector<int> &state) const {
-    return distances[hash_index(state)];
+    return get_value_for_hash_index(hash_index(state));
+}
+
+void PatternDatabase::get_values(
+    const vector<const int *> &states, vector<int> &values) const {
+    int num_states = states.size();
+    values.assign(num_states, 0);
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        int var = pattern[i];
+        if (hash_contributions.empty()) {
+            int multiplier = hash_multipliers[i];
+            for (int j = 0; j < num_states; ++j) {
+                values[j] += multiplier * states[j][var];
+            }
+        } else {
+            const int *contributions = &hash_contributions[value_offsets[i]];
+            for (int j = 0; j < num_states; ++j) {
+                values[j] += contributions[states[j][var]];
+            }
+        }
+    }
+    for (int j = 0; j < num_states; ++j) {
+        values[j] = get_value_for_hash_index(values[j]);
+    }
 }
 
 double PatternDatabase::compute_mean_finite_h() const {
+    if (source_pdb) {
+        // Symmetric PDBs have the same distances up to the order.
+        return source_pdb->compute_mean_finite_h();
+    }
     double sum = 0;
     int size = 0;
     for (size_t i = 0; i < distances.size(); ++i) {
@@ -5,6 +5,7 @@
 
 #include "../task_proxy.h"
 
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -91,13 +92,29 @@ class PatternDatabase {
     /*
       final h-values for abstract-states.
       dead-ends are represented by numeric_limits<int>::max()
+      Empty for PDBs derived from a symmetric PDB (see below).
     */
     std::vector<int> distances;
 
+    /*
+      A PDB derived from a symmetric PDB does not store distances but uses
+      the distances of source_pdb, which always stores its own distances.
+      The hash index of a state is then the index of its symmetric preimage
+      in source_pdb: hash_contributions[value_offsets[i] + value] is the
+      contribution of the given value of the i-th pattern variable to the
+      hash index. Both vectors are empty for other PDBs.
+    */
+    std::shared_ptr<const PatternDatabase> source_pdb;
+    std::vector<int> value_offsets;
+    std::vector<int> hash_contributions;
+
     std::vector<int> generating_op_ids;
     std::vector<std::vector<OperatorID>> wildcard_plan;
 
-    // multipliers for each variable for perfect hash function
+    /*
+      multipliers for each variable for perfect hash function
+      (empty for PDBs derived from a symmetric PDB)
+    */
     std::vector<int> hash_multipliers;
 
     /*
@@ -182,10 +199,49 @@ public:
         bool compute_plan = false,
         const std::shared_ptr<utils::RandomNumberGenerator> &rng = nullptr,
         bool compute_wildcard_plan = false);
+    /*
+      Derive the PDB for the image of the pattern of pdb under a symmetry of
+      the task without a regression search. Position i of the pattern of
+      pdb is mapped to variable image_vars[i], and its value d to value
+      image_values[i][d]. The symmetry must map the goal onto itself and
+      preserve the operator costs used for computing pdb.
+    */
+    PatternDatabase(
+        const std::shared_ptr<PatternDatabase> &pdb,
+        const std::vector<int> &image_vars,
+        const std::vector<std::vector<int>> &image_values);
     ~PatternDatabase() = default;
 
     int get_value(const std::vector<int> &state) const;
 
+    /*
+      Compute the h-values of a batch of states given by pointers to their
+      values one pattern variable at a time.
+    */
+    void get_values(const std::vector<const int *> &states,
+                    std::vector<int> &values) const;
+
+    // Returns the h-value of the abstract state with the given hash index
+    int get_value_for_hash_index(int index) const {
+        return source_pdb ? source_pdb->distances[index] : distances[index];
+    }
+
+    /*
+      Returns the contribution of the given value of the variable at the
+      given position of the pattern to the hash index.
+    */
+    int get_hash_contribution(int pattern_index, int value) const {
+        if (hash_contributions.empty()) {
+            return hash_multipliers[pattern_index] * value;
+        }
+        return hash_contributions[value_offsets[pattern_index] + value];
+    }
+
+    // Returns true iff the PDB shares the distances of a symmetric PDB.
+    bool is_derived_from_symmetric_pdb() const {
+        return source_pdb != nullptr;
+    }
+
     // Returns the pattern (i.e. all variables used) of the PDB
     const Pattern &get_pattern() const {
         return pattern;
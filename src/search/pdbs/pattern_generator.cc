@@ -1,5 +1,6 @@
 #include "pattern_generator.h"
 
+#include "symmetric_pdb_factory.h"
 #include "utils.h"
 
 #include "../plugin.h"
@@ -8,7 +9,9 @@ using namespace std;
 
 namespace pdbs {
 PatternCollectionGenerator::PatternCollectionGenerator(const options::Options &opts)
-    : log(utils::get_log_from_options(opts)) {
+    : log(utils::get_log_from_options(opts)),
+      symmetric_pdb_factory(
+          create_symmetric_pdb_factory_from_options(opts, log)) {
 }
 
 PatternCollectionInformation PatternCollectionGenerator::generate(
@@ -18,6 +21,9 @@ PatternCollectionInformation PatternCollectionGenerator::generate(
     }
     utils::Timer timer;
     PatternCollectionInformation pci = compute_patterns(task);
+    if (symmetric_pdb_factory) {
+        pci.set_symmetric_pdb_factory(symmetric_pdb_factory);
+    }
     dump_pattern_collection_generation_statistics(
         name(), timer(), pci, log);
     return pci;
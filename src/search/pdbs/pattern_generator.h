@@ -22,12 +22,19 @@ class RandomNumberGenerator;
 }
 
 namespace pdbs {
+class SymmetricPDBFactory;
+
 class PatternCollectionGenerator {
     virtual std::string name() const = 0;
     virtual PatternCollectionInformation compute_patterns(
         const std::shared_ptr<AbstractTask> &task) = 0;
 protected:
     mutable utils::LogProxy log;
+    /*
+      Only set for generators that offer the symmetries option (see
+      add_symmetric_pdb_factory_options_to_parser) if it is given.
+    */
+    std::shared_ptr<SymmetricPDBFactory> symmetric_pdb_factory;
 public:
     explicit PatternCollectionGenerator(const options::Options &opts);
     virtual ~PatternCollectionGenerator() = default;
@@ -2,10 +2,12 @@
 
 #include "pattern_database.h"
 #include "pattern_generator.h"
+#include "symmetric_lookups.h"
 
 #include "../option_parser.h"
 #include "../plugin.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 
@@ -22,17 +24,53 @@ shared_ptr<PatternDatabase> get_pdb_from_options(const shared_ptr<AbstractTask>
 
 PDBHeuristic::PDBHeuristic(const Options &opts)
     : Heuristic(opts),
-      pdb(get_pdb_from_options(task, opts)) {
+      pdb(get_pdb_from_options(task, opts)),
+      symmetric_lookups(get_symmetric_lookups_from_options(
+                            opts, task, {pdb}, log)) {
 }
 
 int PDBHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
+    if (symmetric_lookups) {
+        symmetric_lookups->compute_hash_indices(
+            0, state.get_unpacked_values(), hash_indices);
+        int max_h = 0;
+        for (int index : hash_indices) {
+            int h = pdb->get_value_for_hash_index(index);
+            if (h == numeric_limits<int>::max())
+                return DEAD_END;
+            max_h = max(max_h, h);
+        }
+        return max_h;
+    }
     int h = pdb->get_value(state.get_unpacked_values());
     if (h == numeric_limits<int>::max())
         return DEAD_END;
     return h;
 }
 
+void PDBHeuristic::compute_heuristics(
+    const vector<State> &ancestor_states, vector<int> &values) {
+    if (symmetric_lookups) {
+        Heuristic::compute_heuristics(ancestor_states, values);
+        return;
+    }
+    vector<State> states;
+    states.reserve(ancestor_states.size());
+    vector<const int *> state_values;
+    state_values.reserve(ancestor_states.size());
+    for (const State &ancestor_state : ancestor_states) {
+        states.push_back(convert_ancestor_state(ancestor_state));
+        states.back().unpack();
+        state_values.push_back(states.back().get_unpacked_values().data());
+    }
+    pdb->get_values(state_values, values);
+    for (int &h : values) {
+        if (h == numeric_limits<int>::max())
+            h = DEAD_END;
+    }
+}
+
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_synopsis("Pattern database heuristic", "TODO");
     parser.document_language_support("action costs", "supported");
@@ -47,6 +85,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "pattern",
         "pattern generation method",
         "greedy()");
+    add_symmetric_lookups_options_to_parser(parser);
     Heuristic::add_options_to_parser(parser);
 
     Options opts = parser.parse();
@@ -9,12 +9,18 @@ class Options;
 
 namespace pdbs {
 class PatternDatabase;
+class SymmetricLookups;
 
 // Implements a heuristic for a single PDB.
 class PDBHeuristic : public Heuristic {
     std::shared_ptr<PatternDatabase> pdb;
+    std::shared_ptr<SymmetricLookups> symmetric_lookups;
+    std::vector<int> hash_indices;
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual void compute_heuristics(
+        const std::vector<State> &ancestor_states,
+        std::vector<int> &values) override;
 public:
     /*
       Important: It is assumed that the pattern (passed via Options) is
@@ -0,0 +1,161 @@
+#include "symmetric_lookups.h"
+
+#include "pattern_database.h"
+
+#include "../option_parser.h"
+#include "../task_proxy.h"
+
+#include "../structural_symmetries/group.h"
+#include "../structural_symmetries/permutation.h"
+#include "../tasks/root_task.h"
+#include "../utils/logging.h"
+#include "../utils/system.h"
+
+#include <cassert>
+#include <iostream>
+
+using namespace std;
+
+namespace pdbs {
+SymmetricLookups::SymmetricLookups(
+    const Group &group,
+    int max_symmetric_lookups,
+    const PDBCollection &pdbs,
+    utils::LogProxy &log) {
+    assert(group.has_symmetries());
+    int num_vars = group.get_permutation_num_variables();
+
+    vector<RawPermutation> symmetries;
+    symmetries.push_back(group.new_identity_raw_permutation());
+    if (max_symmetric_lookups == 0) {
+        for (int i = 0; i < group.get_num_generators(); ++i) {
+            const Permutation &generator = group.get_permutation(i);
+            RawPermutation raw_generator(group.get_permutation_length());
+            for (int j = 0; j < group.get_permutation_length(); ++j) {
+                raw_generator[j] = generator.get_value(j);
+            }
+            symmetries.push_back(move(raw_generator));
+        }
+    } else {
+        for (RawPermutation &element :
+             group.compute_group_elements(max_symmetric_lookups)) {
+            symmetries.push_back(move(element));
+        }
+    }
+    num_lookups = symmetries.size();
+
+    /*
+      For every symmetry, compute the inverse mapping of variables, i.e., for
+      every variable the variable whose facts are mapped to it.
+    */
+    vector<vector<int>> source_var_by_var(num_lookups, vector<int>(num_vars));
+    for (int k = 0; k < num_lookups; ++k) {
+        for (int var = 0; var < num_vars; ++var) {
+            int index = group.get_index_by_var_val_pair(var, 0);
+            int to_var = group.get_var_val_by_index(symmetries[k][index]).first;
+            source_var_by_var[k][to_var] = var;
+        }
+    }
+
+    int num_table_entries = 0;
+    remappings.reserve(pdbs.size());
+    for (const shared_ptr<PatternDatabase> &pdb : pdbs) {
+        const Pattern &pattern = pdb->get_pattern();
+        PDBRemapping remapping;
+        remapping.pattern_size = pattern.size();
+        remapping.source_vars.reserve(num_lookups * pattern.size());
+        remapping.offsets.reserve(num_lookups * pattern.size());
+        for (int k = 0; k < num_lookups; ++k) {
+            for (size_t i = 0; i < pattern.size(); ++i) {
+                int source_var = source_var_by_var[k][pattern[i]];
+                remapping.source_vars.push_back(source_var);
+                remapping.offsets.push_back(remapping.hash_contributions.size());
+                int first_index = group.get_index_by_var_val_pair(source_var, 0);
+                for (int index = first_index;
+                     index < group.get_permutation_length() &&
+                     group.get_var_val_by_index(index).first == source_var;
+                     ++index) {
+                    pair<int, int> var_val =
+                        group.get_var_val_by_index(symmetries[k][index]);
+                    assert(var_val.first == pattern[i]);
+                    remapping.hash_contributions.push_back(
+                        pdb->get_hash_contribution(i, var_val.second));
+                }
+            }
+        }
+        num_table_entries += remapping.hash_contributions.size();
+        remappings.push_back(move(remapping));
+    }
+
+    if (log.is_at_least_normal()) {
+        log << "Symmetric lookups per state and PDB: " << num_lookups << endl;
+        log << "Symmetric lookup table entries: " << num_table_entries << endl;
+    }
+}
+
+void SymmetricLookups::compute_hash_indices(
+    int pdb_index, const vector<int> &state, vector<int> &hash_indices) const {
+    const PDBRemapping &remapping = remappings[pdb_index];
+    hash_indices.assign(num_lookups, 0);
+    const int *source_var = remapping.source_vars.data();
+    const int *offset = remapping.offsets.data();
+    const int *hash_contributions = remapping.hash_contributions.data();
+    for (int k = 0; k < num_lookups; ++k) {
+        int index = 0;
+        for (int i = 0; i < remapping.pattern_size; ++i) {
+            index += hash_contributions[*offset + state[*source_var]];
+            ++source_var;
+            ++offset;
+        }
+        hash_indices[k] = index;
+    }
+}
+
+void add_symmetric_lookups_options_to_parser(options::OptionParser &parser) {
+    parser.add_option<shared_ptr<Group>>(
+        "symmetries",
+        "symmetries object to compute structural symmetries; if given, the "
+        "heuristic additionally looks up symmetric images of each state and "
+        "uses the maximum value",
+        options::OptionParser::NONE);
+    parser.add_option<int>(
+        "max_symmetric_lookups",
+        "maximum number of symmetries (non-identity group elements, "
+        "enumerated breadth-first from the generators) used for symmetric "
+        "lookups. Use 0 to use exactly the generators.",
+        "0",
+        options::Bounds("0", "infinity"));
+}
+
+shared_ptr<SymmetricLookups> get_symmetric_lookups_from_options(
+    const options::Options &opts,
+    const shared_ptr<AbstractTask> &task,
+    const PDBCollection &pdbs,
+    utils::LogProxy &log) {
+    if (!opts.contains("symmetries")) {
+        return nullptr;
+    }
+    shared_ptr<Group> group = opts.get<shared_ptr<Group>>("symmetries");
+    if (!group->is_stabilizing_goal()) {
+        cerr << "Symmetric lookups require symmetries that stabilize the goal."
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+    if (!group->is_initialized()) {
+        log << "Initializing symmetries (symmetric lookups)" << endl;
+        group->compute_symmetries(TaskProxy(*tasks::g_root_task));
+    }
+    if (!group->has_symmetries()) {
+        log << "No symmetries found, using regular lookups." << endl;
+        return nullptr;
+    }
+    if (group->get_permutation_num_variables() !=
+        static_cast<int>(TaskProxy(*task).get_variables().size())) {
+        cerr << "Symmetric lookups require the variables of the root task."
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+    return make_shared<SymmetricLookups>(
+        *group, opts.get<int>("max_symmetric_lookups"), pdbs, log);
+}
+}
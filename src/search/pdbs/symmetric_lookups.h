@@ -0,0 +1,86 @@
+#ifndef PDBS_SYMMETRIC_LOOKUPS_H
+#define PDBS_SYMMETRIC_LOOKUPS_H
+
+#include "types.h"
+
+#include <memory>
+#include <vector>
+
+class AbstractTask;
+class Group;
+
+namespace options {
+class OptionParser;
+class Options;
+}
+
+namespace utils {
+class LogProxy;
+}
+
+namespace pdbs {
+/*
+  If the structural symmetries of a task stabilize the goal, then every
+  symmetry sigma satisfies h*(s) = h*(sigma(s)). Hence an admissible
+  (consistent) heuristic stays admissible (consistent) if we evaluate it on
+  several symmetric images of the state and take the maximum.
+
+  To make these additional lookups cheap, we never build the permuted state.
+  Instead, we precompute for every PDB and every symmetry how the perfect
+  hash index of the image is computed from the original state: position i of
+  the pattern receives its value from a source variable of the original
+  state, and a table maps the value of that source variable to the
+  contribution of the permuted value to the hash index. The first lookup
+  is always the identity, i.e., the state itself.
+*/
+class SymmetricLookups {
+    struct PDBRemapping {
+        int pattern_size;
+        /*
+          Entry k * pattern_size + i stores the source variable for pattern
+          position i under lookup k and the offset of its value table in
+          hash_contributions.
+        */
+        std::vector<int> source_vars;
+        std::vector<int> offsets;
+        std::vector<int> hash_contributions;
+    };
+
+    int num_lookups;
+    std::vector<PDBRemapping> remappings;
+public:
+    SymmetricLookups(
+        const Group &group,
+        int max_symmetric_lookups,
+        const PDBCollection &pdbs,
+        utils::LogProxy &log);
+
+    // Number of lookups per state and PDB, including the identity.
+    int get_num_lookups() const {
+        return num_lookups;
+    }
+
+    /*
+      Compute the hash indices of all num_lookups symmetric images of the
+      given unpacked state in the PDB with the given index.
+    */
+    void compute_hash_indices(
+        int pdb_index, const std::vector<int> &state,
+        std::vector<int> &hash_indices) const;
+};
+
+extern void add_symmetric_lookups_options_to_parser(
+    options::OptionParser &parser);
+
+/*
+  Returns nullptr if no symmetries have been specified or the task has no
+  symmetries. Computes the symmetries if this has not been done before.
+*/
+extern std::shared_ptr<SymmetricLookups> get_symmetric_lookups_from_options(
+    const options::Options &opts,
+    const std::shared_ptr<AbstractTask> &task,
+    const PDBCollection &pdbs,
+    utils::LogProxy &log);
+}
+
+#endif
@@ -0,0 +1,189 @@
+#include "symmetric_pdb_factory.h"
+
+#include "pattern_database.h"
+
+#include "../option_parser.h"
+#include "../task_proxy.h"
+
+#include "../structural_symmetries/group.h"
+#include "../structural_symmetries/permutation.h"
+#include "../tasks/root_task.h"
+#include "../utils/logging.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <numeric>
+
+using namespace std;
+
+namespace pdbs {
+SymmetricPDBFactory::SymmetricPDBFactory(
+    const shared_ptr<Group> &group, int max_orbit_size)
+    : group(group),
+      max_orbit_size(max_orbit_size),
+      num_derived_pdbs(0) {
+    assert(group->has_symmetries());
+}
+
+static Pattern compute_image(const Permutation &generator, const Pattern &pattern) {
+    Pattern image;
+    image.reserve(pattern.size());
+    for (int var : pattern) {
+        image.push_back(generator.get_new_var_val_by_old_var_val(var, 0).first);
+    }
+    sort(image.begin(), image.end());
+    return image;
+}
+
+void SymmetricPDBFactory::add_orbit(const Pattern &pattern, int pdb_index) {
+    vector<Pattern> orbit;
+    int first_entry_id = orbit_entries.size();
+    orbit.push_back(pattern);
+    orbit_entries.push_back({pdb_index, -1, -1});
+    orbit_entry_by_pattern[pattern] = first_entry_id;
+    for (size_t i = 0; i < orbit.size(); ++i) {
+        for (int gen = 0; gen < group->get_num_generators(); ++gen) {
+            if (static_cast<int>(orbit.size()) >= max_orbit_size) {
+                return;
+            }
+            Pattern image = compute_image(group->get_permutation(gen), orbit[i]);
+            if (orbit_entry_by_pattern.count(image)) {
+                continue;
+            }
+            orbit_entry_by_pattern[image] = orbit_entries.size();
+            int parent = first_entry_id + i;
+            orbit_entries.push_back({pdb_index, parent, gen});
+            orbit.push_back(move(image));
+        }
+    }
+}
+
+shared_ptr<PatternDatabase> SymmetricPDBFactory::derive_pdb(
+    const TaskProxy &task_proxy, int entry_id) const {
+    const OrbitEntry &entry = orbit_entries[entry_id];
+    const shared_ptr<PatternDatabase> &pdb = computed_pdbs[entry.pdb_index];
+
+    // Collect the generators on the path from the computed pattern.
+    vector<int> generators;
+    for (int id = entry_id; orbit_entries[id].parent != -1;
+         id = orbit_entries[id].parent) {
+        generators.push_back(orbit_entries[id].generator);
+    }
+    reverse(generators.begin(), generators.end());
+
+    const Pattern &pattern = pdb->get_pattern();
+    VariablesProxy variables = task_proxy.get_variables();
+    vector<int> image_vars(pattern);
+    vector<vector<int>> image_values;
+    image_values.reserve(pattern.size());
+    for (int var : pattern) {
+        vector<int> values(variables[var].get_domain_size());
+        iota(values.begin(), values.end(), 0);
+        image_values.push_back(move(values));
+    }
+    for (int gen : generators) {
+        const Permutation &generator = group->get_permutation(gen);
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            int var = image_vars[i];
+            for (int &value : image_values[i]) {
+                pair<int, int> var_val =
+                    generator.get_new_var_val_by_old_var_val(var, value);
+                image_vars[i] = var_val.first;
+                value = var_val.second;
+            }
+        }
+    }
+    return make_shared<PatternDatabase>(pdb, image_vars, image_values);
+}
+
+shared_ptr<PatternDatabase> SymmetricPDBFactory::create_pdb(
+    const TaskProxy &task_proxy, const Pattern &pattern) {
+    if (group->get_permutation_num_variables() !=
+        static_cast<int>(task_proxy.get_variables().size())) {
+        cerr << "Symmetric PDBs require the variables of the root task."
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+    auto it = orbit_entry_by_pattern.find(pattern);
+    if (it != orbit_entry_by_pattern.end()) {
+        ++num_derived_pdbs;
+        shared_ptr<PatternDatabase> pdb = derive_pdb(task_proxy, it->second);
+        assert(pdb->get_pattern() == pattern);
+        return pdb;
+    }
+    shared_ptr<PatternDatabase> pdb =
+        make_shared<PatternDatabase>(task_proxy, pattern);
+    computed_pdbs.push_back(pdb);
+    add_orbit(pattern, computed_pdbs.size() - 1);
+    return pdb;
+}
+
+PatternCollection SymmetricPDBFactory::compute_pattern_orbit(
+    const Pattern &pattern) const {
+    PatternCollection orbit;
+    utils::HashSet<Pattern> reached;
+    orbit.push_back(pattern);
+    reached.insert(pattern);
+    for (size_t i = 0; i < orbit.size(); ++i) {
+        for (int gen = 0; gen < group->get_num_generators(); ++gen) {
+            if (static_cast<int>(orbit.size()) >= max_orbit_size) {
+                return orbit;
+            }
+            Pattern image = compute_image(group->get_permutation(gen), orbit[i]);
+            if (reached.insert(image).second) {
+                orbit.push_back(move(image));
+            }
+        }
+    }
+    return orbit;
+}
+
+void SymmetricPDBFactory::print_statistics(utils::LogProxy &log) const {
+    if (log.is_at_least_normal()) {
+        log << "Symmetric PDBs computed: " << computed_pdbs.size() << endl;
+        log << "Symmetric PDBs derived: " << num_derived_pdbs << endl;
+        log << "Symmetric PDB orbit entries: " << orbit_entries.size() << endl;
+    }
+}
+
+void add_symmetric_pdb_factory_options_to_parser(options::OptionParser &parser) {
+    parser.add_option<shared_ptr<Group>>(
+        "symmetries",
+        "symmetries object to compute structural symmetries; if given, PDBs "
+        "for patterns that are symmetric to the pattern of an already "
+        "computed PDB share the distances of that PDB instead of being "
+        "computed",
+        options::OptionParser::NONE);
+    parser.add_option<int>(
+        "max_pattern_orbit_size",
+        "maximum number of patterns enumerated in the orbit of the pattern "
+        "of each computed PDB",
+        "1000",
+        options::Bounds("1", "infinity"));
+}
+
+shared_ptr<SymmetricPDBFactory> create_symmetric_pdb_factory_from_options(
+    const options::Options &opts, utils::LogProxy &log) {
+    if (!opts.contains("symmetries")) {
+        return nullptr;
+    }
+    shared_ptr<Group> group = opts.get<shared_ptr<Group>>("symmetries");
+    if (!group->is_stabilizing_goal()) {
+        cerr << "Symmetric PDBs require symmetries that stabilize the goal."
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+    if (!group->is_initialized()) {
+        log << "Initializing symmetries (symmetric PDBs)" << endl;
+        group->compute_symmetries(TaskProxy(*tasks::g_root_task));
+    }
+    if (!group->has_symmetries()) {
+        log << "No symmetries found, computing all PDBs." << endl;
+        return nullptr;
+    }
+    return make_shared<SymmetricPDBFactory>(
+        group, opts.get<int>("max_pattern_orbit_size"));
+}
+}
@@ -0,0 +1,92 @@
+#ifndef PDBS_SYMMETRIC_PDB_FACTORY_H
+#define PDBS_SYMMETRIC_PDB_FACTORY_H
+
+#include "types.h"
+
+#include "../utils/hash.h"
+
+#include <memory>
+#include <vector>
+
+class Group;
+class TaskProxy;
+
+namespace options {
+class OptionParser;
+class Options;
+}
+
+namespace utils {
+class LogProxy;
+}
+
+namespace pdbs {
+/*
+  Creates PDBs for patterns and avoids the regression search for patterns
+  that are images of the pattern of an already computed PDB under a
+  structural symmetry of the task. Such PDBs are derived from the computed
+  PDB: they only store a remapping of variables and values and share its
+  distances.
+
+  For every computed PDB, we enumerate the orbit of its pattern under the
+  generators breadth-first (up to max_orbit_size patterns) and store for
+  every pattern in the orbit the generator and the predecessor pattern it
+  was reached from. The symmetry mapping the computed pattern onto a
+  pattern in the orbit is then recovered by following these predecessors.
+
+  The symmetries must stabilize the goal, and the PDBs must be computed with
+  the operator costs of the task (which symmetries preserve).
+*/
+class SymmetricPDBFactory {
+    struct OrbitEntry {
+        // Index of the computed PDB in computed_pdbs.
+        int pdb_index;
+        // Index of the predecessor entry or -1 for the computed pattern.
+        int parent;
+        int generator;
+    };
+
+    std::shared_ptr<Group> group;
+    const int max_orbit_size;
+    std::vector<std::shared_ptr<PatternDatabase>> computed_pdbs;
+    std::vector<OrbitEntry> orbit_entries;
+    utils::HashMap<Pattern, int> orbit_entry_by_pattern;
+
+    int num_derived_pdbs;
+
+    void add_orbit(const Pattern &pattern, int pdb_index);
+    std::shared_ptr<PatternDatabase> derive_pdb(
+        const TaskProxy &task_proxy, int entry_id) const;
+public:
+    SymmetricPDBFactory(
+        const std::shared_ptr<Group> &group, int max_orbit_size);
+
+    /*
+      Return the PDB for the given pattern, deriving it from a symmetric PDB
+      if possible.
+    */
+    std::shared_ptr<PatternDatabase> create_pdb(
+        const TaskProxy &task_proxy, const Pattern &pattern);
+
+    /*
+      Return the orbit of the given pattern under the generators, starting
+      with the pattern itself. At most max_orbit_size patterns are
+      enumerated, so the result can be a proper subset of the orbit.
+    */
+    PatternCollection compute_pattern_orbit(const Pattern &pattern) const;
+
+    void print_statistics(utils::LogProxy &log) const;
+};
+
+extern void add_symmetric_pdb_factory_options_to_parser(
+    options::OptionParser &parser);
+
+/*
+  Returns nullptr if no symmetries have been specified or the task has no
+  symmetries. Computes the symmetries if this has not been done before.
+*/
+extern std::shared_ptr<SymmetricPDBFactory> create_symmetric_pdb_factory_from_options(
+    const options::Options &opts, utils::LogProxy &log);
+}
+
+#endif
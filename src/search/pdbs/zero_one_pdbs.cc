@@ -1,11 +1,13 @@
 #include "zero_one_pdbs.h"
 
 #include "pattern_database.h"
+#include "symmetric_lookups.h"
 
 #include "../task_proxy.h"
 
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -38,8 +40,15 @@ ZeroOnePDBs::ZeroOnePDBs(
     }
 }
 
+void ZeroOnePDBs::set_symmetric_lookups(
+    const shared_ptr<SymmetricLookups> &symmetric_lookups_) {
+    symmetric_lookups = symmetric_lookups_;
+}
 
 int ZeroOnePDBs::get_value(const State &state) const {
+    if (symmetric_lookups) {
+        return get_value_with_symmetric_lookups(state);
+    }
     /*
       Because we use cost partitioning, we can simply add up all
       heuristic values of all patterns in the pattern collection.
@@ -55,6 +64,29 @@ int ZeroOnePDBs::get_value(const State &state) const {
     return h_val;
 }
 
+int ZeroOnePDBs::get_value_with_symmetric_lookups(const State &state) const {
+    /*
+      The cost partitioning yields an admissible heuristic for every
+      symmetric image of the state, so we sum up the values per image and
+      use the maximum sum.
+    */
+    vector<int> h_values(symmetric_lookups->get_num_lookups(), 0);
+    vector<int> hash_indices;
+    state.unpack();
+    for (size_t i = 0; i < pattern_databases.size(); ++i) {
+        const PatternDatabase &pdb = *pattern_databases[i];
+        symmetric_lookups->compute_hash_indices(
+            i, state.get_unpacked_values(), hash_indices);
+        for (size_t k = 0; k < hash_indices.size(); ++k) {
+            int pdb_value = pdb.get_value_for_hash_index(hash_indices[k]);
+            if (pdb_value == numeric_limits<int>::max())
+                return numeric_limits<int>::max();
+            h_values[k] += pdb_value;
+        }
+    }
+    return *max_element(h_values.begin(), h_values.end());
+}
+
 double ZeroOnePDBs::compute_approx_mean_finite_h() const {
     double approx_mean_finite_h = 0;
     for (const shared_ptr<PatternDatabase> &pdb : pattern_databases) {
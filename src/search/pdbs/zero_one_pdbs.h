@@ -3,6 +3,8 @@
 
 #include "types.h"
 
+#include <memory>
+
 class State;
 class TaskProxy;
 
@@ -11,12 +13,24 @@ class LogProxy;
 }
 
 namespace pdbs {
+class SymmetricLookups;
+
 class ZeroOnePDBs {
     PDBCollection pattern_databases;
+    // If set, maximize over the symmetric images of the state.
+    std::shared_ptr<SymmetricLookups> symmetric_lookups;
+
+    int get_value_with_symmetric_lookups(const State &state) const;
 public:
     ZeroOnePDBs(const TaskProxy &task_proxy, const PatternCollection &patterns);
     ~ZeroOnePDBs() = default;
 
+    const PDBCollection &get_pattern_databases() const {
+        return pattern_databases;
+    }
+    void set_symmetric_lookups(
+        const std::shared_ptr<SymmetricLookups> &symmetric_lookups);
+
     int get_value(const State &state) const;
     /*
       Returns the sum of all mean finite h-values of every PDB.
@@ -1,6 +1,7 @@
 #include "zero_one_pdbs_heuristic.h"
 
 #include "pattern_generator.h"
+#include "symmetric_lookups.h"
 
 #include "../option_parser.h"
 #include "../plugin.h"
@@ -11,7 +12,8 @@ using namespace std;
 
 namespace pdbs {
 ZeroOnePDBs get_zero_one_pdbs_from_options(
-    const shared_ptr<AbstractTask> &task, const Options &opts) {
+    const shared_ptr<AbstractTask> &task, const Options &opts,
+    utils::LogProxy &log) {
     shared_ptr<PatternCollectionGenerator> pattern_generator =
         opts.get<shared_ptr<PatternCollectionGenerator>>("patterns");
     PatternCollectionInformation pattern_collection_info =
@@ -19,13 +21,17 @@ ZeroOnePDBs get_zero_one_pdbs_from_options(
     shared_ptr<PatternCollection> patterns =
         pattern_collection_info.get_patterns();
     TaskProxy task_proxy(*task);
-    return ZeroOnePDBs(task_proxy, *patterns);
+    ZeroOnePDBs zero_one_pdbs(task_proxy, *patterns);
+    zero_one_pdbs.set_symmetric_lookups(
+        get_symmetric_lookups_from_options(
+            opts, task, zero_one_pdbs.get_pattern_databases(), log));
+    return zero_one_pdbs;
 }
 
 ZeroOnePDBsHeuristic::ZeroOnePDBsHeuristic(
     const options::Options &opts)
     : Heuristic(opts),
-      zero_one_pdbs(get_zero_one_pdbs_from_options(task, opts)) {
+      zero_one_pdbs(get_zero_one_pdbs_from_options(task, opts, log)) {
 }
 
 int ZeroOnePDBsHeuristic::compute_heuristic(const State &ancestor_state) {
@@ -60,6 +66,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "patterns",
         "pattern generation method",
         "systematic(1)");
+    add_symmetric_lookups_options_to_parser(parser);
     Heuristic::add_options_to_parser(parser);
 
     Options opts = parser.parse();
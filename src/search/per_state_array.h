@@ -47,18 +47,18 @@ template<class Element>
 class PerStateArray : public subscriber::Subscriber<StateRegistry> {
     const std::vector<Element> default_array;
     using EntryArrayVectorMap = std::unordered_map<const StateRegistry *,
-                                                   segmented_vector::SegmentedArrayVector<Element> *>;
+                                                   segmented_vector::SpillableSegmentedArrayVector<Element> *>;
     EntryArrayVectorMap entry_arrays_by_registry;
 
     mutable const StateRegistry *cached_registry;
-    mutable segmented_vector::SegmentedArrayVector<Element> *cached_entries;
+    mutable segmented_vector::SpillableSegmentedArrayVector<Element> *cached_entries;
 
-    segmented_vector::SegmentedArrayVector<Element> *get_entries(const StateRegistry *registry) {
+    segmented_vector::SpillableSegmentedArrayVector<Element> *get_entries(const StateRegistry *registry) {
         if (cached_registry != registry) {
             cached_registry = registry;
             auto it = entry_arrays_by_registry.find(registry);
             if (it == entry_arrays_by_registry.end()) {
-                cached_entries = new segmented_vector::SegmentedArrayVector<Element>(
+                cached_entries = new segmented_vector::SpillableSegmentedArrayVector<Element>(
                     default_array.size());
                 entry_arrays_by_registry[registry] = cached_entries;
                 registry->subscribe(this);
@@ -70,7 +70,7 @@ class PerStateArray : public subscriber::Subscriber<StateRegistry> {
         return cached_entries;
     }
 
-    const segmented_vector::SegmentedArrayVector<Element> *get_entries(
+    const segmented_vector::SpillableSegmentedArrayVector<Element> *get_entries(
         const StateRegistry *registry) const {
         if (cached_registry != registry) {
             const auto it = entry_arrays_by_registry.find(registry);
@@ -78,7 +78,7 @@ class PerStateArray : public subscriber::Subscriber<StateRegistry> {
                 return nullptr;
             } else {
                 cached_registry = registry;
-                cached_entries = const_cast<segmented_vector::SegmentedArrayVector<Element> *>(
+                cached_entries = const_cast<segmented_vector::SpillableSegmentedArrayVector<Element> *>(
                     it->second);
             }
         }
@@ -109,7 +109,7 @@ public:
                       << "state." << std::endl;
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
-        segmented_vector::SegmentedArrayVector<Element> *entries = get_entries(registry);
+        segmented_vector::SpillableSegmentedArrayVector<Element> *entries = get_entries(registry);
         int state_id = state.get_id().value;
         assert(state.get_id() != StateID::no_state);
         size_t virtual_size = registry->size();
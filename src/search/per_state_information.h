@@ -40,11 +40,11 @@ template<class Entry>
 class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
     const Entry default_value;
     using EntryVectorMap = std::unordered_map<const StateRegistry *,
-                                              segmented_vector::SegmentedVector<Entry> * >;
+                                              segmented_vector::SpillableSegmentedVector<Entry> * >;
     EntryVectorMap entries_by_registry;
 
     mutable const StateRegistry *cached_registry;
-    mutable segmented_vector::SegmentedVector<Entry> *cached_entries;
+    mutable segmented_vector::SpillableSegmentedVector<Entry> *cached_entries;
 
     /*
       Returns the SegmentedVector associated with the given StateRegistry.
@@ -52,12 +52,12 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
       Both the registry and the returned vector are cached to speed up
       consecutive calls with the same registry.
     */
-    segmented_vector::SegmentedVector<Entry> *get_entries(const StateRegistry *registry) {
+    segmented_vector::SpillableSegmentedVector<Entry> *get_entries(const StateRegistry *registry) {
         if (cached_registry != registry) {
             cached_registry = registry;
             auto it = entries_by_registry.find(registry);
             if (it == entries_by_registry.end()) {
-                cached_entries = new segmented_vector::SegmentedVector<Entry>();
+                cached_entries = new segmented_vector::SpillableSegmentedVector<Entry>();
                 entries_by_registry[registry] = cached_entries;
                 registry->subscribe(this);
             } else {
@@ -74,14 +74,14 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
       Otherwise, both the registry and the returned vector are cached to speed
       up consecutive calls with the same registry.
     */
-    const segmented_vector::SegmentedVector<Entry> *get_entries(const StateRegistry *registry) const {
+    const segmented_vector::SpillableSegmentedVector<Entry> *get_entries(const StateRegistry *registry) const {
         if (cached_registry != registry) {
             const auto it = entries_by_registry.find(registry);
             if (it == entries_by_registry.end()) {
                 return nullptr;
             } else {
                 cached_registry = registry;
-                cached_entries = const_cast<segmented_vector::SegmentedVector<Entry> *>(it->second);
+                cached_entries = const_cast<segmented_vector::SpillableSegmentedVector<Entry> *>(it->second);
             }
         }
         assert(cached_registry == registry);
@@ -117,7 +117,7 @@ public:
                       << "unregistered state." << std::endl;
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
-        segmented_vector::SegmentedVector<Entry> *entries = get_entries(registry);
+        segmented_vector::SpillableSegmentedVector<Entry> *entries = get_entries(registry);
         int state_id = state.get_id().value;
         assert(state.get_id() != StateID::no_state);
         size_t virtual_size = registry->size();
@@ -135,7 +135,7 @@ public:
                       << "unregistered state." << std::endl;
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
-        const segmented_vector::SegmentedVector<Entry> *entries = get_entries(registry);
+        const segmented_vector::SpillableSegmentedVector<Entry> *entries = get_entries(registry);
         if (!entries) {
             return default_value;
         }
@@ -26,4 +26,22 @@ int PotentialFunction::get_value(const State &state) const {
     const double epsilon = 0.01;
     return static_cast<int>(ceil(heuristic_value - epsilon));
 }
+
+void PotentialFunction::get_values(
+    const vector<const int *> &states, vector<int> &values) const {
+    int num_states = states.size();
+    vector<double> heuristic_values(num_states, 0.0);
+    for (size_t var_id = 0; var_id < fact_potentials.size(); ++var_id) {
+        const vector<double> &potentials = fact_potentials[var_id];
+        for (int i = 0; i < num_states; ++i) {
+            assert(utils::in_bounds(states[i][var_id], potentials));
+            heuristic_values[i] += potentials[states[i][var_id]];
+        }
+    }
+    const double epsilon = 0.01;
+    values.resize(num_states);
+    for (int i = 0; i < num_states; ++i) {
+        values[i] = static_cast<int>(ceil(heuristic_values[i] - epsilon));
+    }
+}
 }
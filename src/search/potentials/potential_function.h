@@ -21,6 +21,9 @@ public:
     ~PotentialFunction() = default;
 
     int get_value(const State &state) const;
+    // Batch version of get_value for states given by their unpacked values.
+    void get_values(const std::vector<const int *> &states,
+                    std::vector<int> &values) const;
 };
 }
 
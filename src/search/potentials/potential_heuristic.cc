@@ -20,4 +20,21 @@ int PotentialHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     return max(0, function->get_value(state));
 }
+
+void PotentialHeuristic::compute_heuristics(
+    const vector<State> &ancestor_states, vector<int> &values) {
+    vector<State> states;
+    states.reserve(ancestor_states.size());
+    vector<const int *> state_values;
+    state_values.reserve(ancestor_states.size());
+    for (const State &ancestor_state : ancestor_states) {
+        states.push_back(convert_ancestor_state(ancestor_state));
+        states.back().unpack();
+        state_values.push_back(states.back().get_unpacked_values().data());
+    }
+    function->get_values(state_values, values);
+    for (int &h : values) {
+        h = max(0, h);
+    }
+}
 }
@@ -16,6 +16,9 @@ class PotentialHeuristic : public Heuristic {
 
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual void compute_heuristics(
+        const std::vector<State> &ancestor_states,
+        std::vector<int> &values) override;
 
 public:
     explicit PotentialHeuristic(
@@ -4,11 +4,16 @@
 
 #include "../option_parser.h"
 
+#include "../lp/lp_folding.h"
+#include "../structural_symmetries/group.h"
+#include "../structural_symmetries/permutation.h"
 #include "../task_utils/task_properties.h"
+#include "../tasks/root_task.h"
 #include "../utils/collections.h"
 #include "../utils/memory.h"
 #include "../utils/system.h"
 
+#include <iostream>
 #include <limits>
 #include <unordered_map>
 
@@ -25,6 +30,8 @@ PotentialOptimizer::PotentialOptimizer(const Options &opts)
       task_proxy(*task),
       lp_solver(opts.get<lp::LPSolverType>("lpsolver")),
       max_potential(opts.get<double>("max_potential")),
+      symmetries(opts.get<shared_ptr<Group>>("symmetries", nullptr)),
+      log(utils::get_log_from_options(opts)),
       num_lp_vars(0) {
     task_properties::verify_no_axioms(task_proxy);
     task_properties::verify_no_conditional_effects(task_proxy);
@@ -98,6 +105,48 @@ bool PotentialOptimizer::potentials_are_bounded() const {
     return max_potential != numeric_limits<double>::infinity();
 }
 
+vector<vector<int>> PotentialOptimizer::compute_lp_variable_permutations() {
+    if (!symmetries->is_initialized()) {
+        log << "Initializing symmetries (potential heuristics)" << endl;
+        symmetries->compute_symmetries(TaskProxy(*tasks::g_root_task));
+    }
+    VariablesProxy vars = task_proxy.get_variables();
+    if (symmetries->has_symmetries() &&
+        symmetries->get_permutation_num_variables() !=
+        static_cast<int>(vars.size())) {
+        cerr << "Folding potential LPs requires the variables of the root "
+             << "task." << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+
+    /*
+      Permute the fact potentials by the permutations of the generators and
+      map the potential of the undefined value of a variable to the one of
+      its image.
+    */
+    vector<vector<int>> permutations;
+    permutations.reserve(symmetries->get_num_generators());
+    for (int gen = 0; gen < symmetries->get_num_generators(); ++gen) {
+        const Permutation &generator = symmetries->get_permutation(gen);
+        vector<int> permutation(num_lp_vars);
+        for (VariableProxy var : vars) {
+            int var_id = var.get_id();
+            int image_var_id = -1;
+            for (int val = 0; val < var.get_domain_size(); ++val) {
+                pair<int, int> image =
+                    generator.get_new_var_val_by_old_var_val(var_id, val);
+                image_var_id = image.first;
+                permutation[lp_var_ids[var_id][val]] =
+                    lp_var_ids[image.first][image.second];
+            }
+            permutation[lp_var_ids[var_id][get_undefined_value(var)]] =
+                lp_var_ids[image_var_id][get_undefined_value(vars[image_var_id])];
+        }
+        permutations.push_back(move(permutation));
+    }
+    return permutations;
+}
+
 void PotentialOptimizer::construct_lp() {
     double infinity = lp_solver.get_infinity();
     double upper_bound = (potentials_are_bounded() ? max_potential : infinity);
@@ -185,7 +234,15 @@ void PotentialOptimizer::construct_lp() {
     }
     lp::LinearProgram lp(lp::LPObjectiveSense::MAXIMIZE, move(lp_variables),
                          move(lp_constraints), infinity);
-    lp_solver.load_problem(lp);
+    if (symmetries) {
+        unique_ptr<lp::LPFolding> folding =
+            utils::make_unique_ptr<lp::LPFolding>(
+                lp, compute_lp_variable_permutations());
+        folding->print_statistics(log);
+        lp_solver.load_folded_problem(lp, move(folding));
+    } else {
+        lp_solver.load_problem(lp);
+    }
 }
 
 void PotentialOptimizer::solve_and_extract() {
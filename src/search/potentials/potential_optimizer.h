@@ -4,10 +4,13 @@
 #include "../task_proxy.h"
 
 #include "../lp/lp_solver.h"
+#include "../utils/logging.h"
 
 #include <memory>
 #include <vector>
 
+class Group;
+
 namespace options {
 class Options;
 }
@@ -46,12 +49,15 @@ class PotentialOptimizer {
     TaskProxy task_proxy;
     lp::LPSolver lp_solver;
     const double max_potential;
+    std::shared_ptr<Group> symmetries;
+    utils::LogProxy log;
     int num_lp_vars;
     std::vector<std::vector<int>> lp_var_ids;
     std::vector<std::vector<double>> fact_potentials;
 
     int get_lp_var_id(const FactProxy &fact) const;
     void initialize();
+    std::vector<std::vector<int>> compute_lp_variable_permutations();
     void construct_lp();
     void solve_and_extract();
     void extract_lp_solution();
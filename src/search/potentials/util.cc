@@ -6,6 +6,7 @@
 #include "../heuristic.h"
 #include "../option_parser.h"
 
+#include "../structural_symmetries/group.h"
 #include "../task_utils/sampling.h"
 #include "../utils/markup.h"
 
@@ -62,6 +63,14 @@ void prepare_parser_for_admissible_potentials(OptionParser &parser) {
         "heuristics. For details, see the ICAPS paper cited above.",
         "1e8",
         Bounds("0.0", "infinity"));
+    parser.add_option<shared_ptr<Group>>(
+        "symmetries",
+        "symmetries object to compute structural symmetries; if given, the "
+        "LP is folded by the symmetries of the task that are symmetries of "
+        "the LP, which restricts it to potential functions that assign "
+        "symmetric facts the same potential. The resulting potentials are "
+        "admissible but may be less informed for the optimized states.",
+        OptionParser::NONE);
     lp::add_lp_solver_option_to_parser(parser);
     Heuristic::add_options_to_parser(parser);
 }
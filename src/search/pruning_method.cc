@@ -13,6 +13,7 @@ using namespace std;
 
 PruningMethod::PruningMethod(const options::Options &opts)
     : timer(false),
+      report_per_orbit(false),
       log(utils::get_log_from_options(opts)),
       task(nullptr) {
 }
@@ -22,6 +23,8 @@ void PruningMethod::initialize(const shared_ptr<AbstractTask> &task_) {
     task = task_;
     num_successors_before_pruning = 0;
     num_successors_after_pruning = 0;
+    num_pruned_states = 0;
+    num_states_with_pruned_successors = 0;
 }
 
 void PruningMethod::prune_operators(
@@ -39,6 +42,10 @@ void PruningMethod::prune_operators(
     prune(state, op_ids);
     num_successors_before_pruning += num_ops_before_pruning;
     num_successors_after_pruning += op_ids.size();
+    ++num_pruned_states;
+    if (static_cast<int>(op_ids.size()) < num_ops_before_pruning) {
+        ++num_states_with_pruned_successors;
+    }
     if (log.is_at_least_verbose()) {
         timer.stop();
     }
@@ -54,12 +61,29 @@ void PruningMethod::print_statistics() const {
             static_cast<double>(num_successors_after_pruning) /
             static_cast<double>(num_successors_before_pruning));
         log << "Pruning ratio: " << pruning_ratio << endl;
+        if (report_per_orbit) {
+            print_orbit_statistics();
+        }
         if (log.is_at_least_verbose()) {
             log << "Time for pruning operators: " << timer << endl;
         }
     }
 }
 
+void PruningMethod::print_orbit_statistics() const {
+    log << "Orbits considered for pruning: " << num_pruned_states << endl
+        << "Orbits with pruned successors: "
+        << num_states_with_pruned_successors << endl;
+    if (num_pruned_states > 0) {
+        log << "Average successors per orbit before pruning: "
+            << static_cast<double>(num_successors_before_pruning) /
+            num_pruned_states << endl
+            << "Average successors per orbit after pruning: "
+            << static_cast<double>(num_successors_after_pruning) /
+            num_pruned_states << endl;
+    }
+}
+
 void add_pruning_options_to_parser(options::OptionParser &parser) {
     utils::add_log_options_to_parser(parser);
     parser.document_note(
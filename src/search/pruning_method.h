@@ -24,6 +24,8 @@ class Options;
 class PruningMethod {
     utils::Timer timer;
     friend class limited_pruning::LimitedPruning;
+    // True iff every state passed to prune_operators represents an orbit.
+    bool report_per_orbit;
 
     virtual void prune(
         const State &state, std::vector<OperatorID> &op_ids) = 0;
@@ -32,11 +34,23 @@ protected:
     std::shared_ptr<AbstractTask> task;
     long num_successors_before_pruning;
     long num_successors_after_pruning;
+    long num_pruned_states;
+    long num_states_with_pruned_successors;
+
+    void print_orbit_statistics() const;
 public:
     explicit PruningMethod(const options::Options &opts);
     virtual ~PruningMethod() = default;
     virtual void initialize(const std::shared_ptr<AbstractTask> &task);
     void prune_operators(const State &state, std::vector<OperatorID> &op_ids);
+    /*
+      Called by search engines that prune symmetric states: every state
+      passed to prune_operators then stands for its orbit and we
+      additionally report the statistics per orbit.
+    */
+    void set_report_per_orbit() {
+        report_per_orbit = true;
+    }
     virtual void print_statistics() const;
 };
 
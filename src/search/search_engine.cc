@@ -6,6 +6,7 @@
 #include "plugin.h"
 
 #include "algorithms/ordered_set.h"
+#include "structural_symmetries/group.h"
 #include "task_utils/successor_generator.h"
 #include "task_utils/task_properties.h"
 #include "tasks/root_task.h"
@@ -15,6 +16,7 @@
 #include "utils/timer.h"
 
 #include <cassert>
+#include <fstream>
 #include <iostream>
 #include <limits>
 
@@ -47,7 +49,8 @@ SearchEngine::SearchEngine(const Options &opts)
       task(tasks::g_root_task),
       task_proxy(*task),
       log(utils::get_log_from_options(opts)),
-      state_registry(task_proxy),
+      state_registry(
+          task_proxy, opts.get<StateCompression>("state_compression")),
       successor_generator(get_successor_generator(task_proxy, log)),
       search_space(state_registry, log),
       statistics(log),
@@ -60,6 +63,44 @@ SearchEngine::SearchEngine(const Options &opts)
     }
     bound = opts.get<int>("bound");
     task_properties::print_variable_statistics(task_proxy);
+
+    /*
+      The group has to be set up here rather than in the derived engines
+      because some of them register the initial state during construction.
+    */
+    if (opts.contains("symmetries")) {
+        group = opts.get<shared_ptr<Group>>("symmetries");
+        symmetry_statistics_file =
+            opts.get<string>("symmetry_statistics_file", "");
+        if (group->get_search_symmetries() == SearchSymmetries::NONE) {
+            cerr << "Symmetries option passed to search engine, but no "
+                 << "search symmetries should be used." << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        /*
+          Pruning symmetric states is only safe if symmetric states have the
+          same goal distance, which requires symmetries mapping goal states
+          to goal states.
+        */
+        if (!group->is_stabilizing_goal()) {
+            cerr << "Search symmetries must stabilize the goal." << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        if (opts.get<StateCompression>("state_compression") !=
+            StateCompression::NONE) {
+            cerr << "Search symmetries do not support state compression."
+                 << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        if (!group->is_initialized()) {
+            log << "Initializing symmetries" << endl;
+            group->compute_symmetries(TaskProxy(*tasks::g_root_task));
+        }
+        if (use_dks()) {
+            log << "Setting group in registry for DKS search" << endl;
+            state_registry.set_group(group);
+        }
+    }
 }
 
 SearchEngine::~SearchEngine() {
@@ -98,8 +139,82 @@ void SearchEngine::search() {
     log << "Actual search time: " << timer.get_elapsed_time() << endl;
 }
 
-bool SearchEngine::check_goal_and_set_plan(
-    const State &state, const shared_ptr<Group> &group) {
+bool SearchEngine::use_oss() const {
+    return group && group->has_symmetries() &&
+           group->get_search_symmetries() == SearchSymmetries::OSS;
+}
+
+bool SearchEngine::use_dks() const {
+    return group && group->has_symmetries() &&
+           group->get_search_symmetries() == SearchSymmetries::DKS;
+}
+
+State SearchEngine::get_initial_search_state() {
+    const State &initial_state = state_registry.get_initial_state();
+    if (use_oss()) {
+        return state_registry.register_canonical_state(initial_state, *group);
+    }
+    return initial_state;
+}
+
+State SearchEngine::get_search_successor_state(
+    const State &state, const OperatorProxy &op) {
+    if (use_oss() || use_dks()) {
+        long long num_symmetric_duplicates =
+            state_registry.get_num_symmetric_duplicates();
+        vector<int> *permutation_trace = group->records_traces() ?
+            &successor_permutation_trace : nullptr;
+        State succ_state = use_oss() ?
+            state_registry.get_canonical_successor_state(
+                state, op, *group, permutation_trace) :
+            state_registry.get_successor_state(state, op, permutation_trace);
+        statistics.inc_symmetric_duplicates(
+            state_registry.get_num_symmetric_duplicates() -
+            num_symmetric_duplicates);
+        return succ_state;
+    }
+    return state_registry.get_successor_state(state, op);
+}
+
+void SearchEngine::record_permutation_trace(const State &succ_state) {
+    if ((use_oss() || use_dks()) && group->records_traces()) {
+        search_space.set_permutation_trace(
+            succ_state, vector<int>(successor_permutation_trace));
+    }
+}
+
+void SearchEngine::print_symmetry_statistics() const {
+    if (use_oss() || use_dks()) {
+        group->print_canonicalization_statistics();
+        if (!symmetry_statistics_file.empty()) {
+            write_symmetry_statistics_file();
+        }
+    }
+}
+
+void SearchEngine::write_symmetry_statistics_file() const {
+    ofstream file(symmetry_statistics_file);
+    if (!file) {
+        cerr << "Could not open symmetry statistics file "
+             << symmetry_statistics_file << endl;
+        utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    file << "{\"search_symmetries\": \""
+         << (use_oss() ? "oss" : "dks") << "\""
+         << ", \"generators\": " << group->get_num_generators()
+         << ", \"expanded\": " << statistics.get_expanded()
+         << ", \"evaluated\": " << statistics.get_evaluated_states()
+         << ", \"generated\": " << statistics.get_generated()
+         << ", \"symmetric_duplicates\": "
+         << statistics.get_symmetric_duplicates()
+         << ", \"canonicalization\": ";
+    group->write_canonicalization_statistics(file);
+    file << "}" << endl;
+    log << "Symmetry statistics written to " << symmetry_statistics_file
+        << endl;
+}
+
+bool SearchEngine::check_goal_and_set_plan(const State &state) {
     if (task_properties::is_goal_state(task_proxy, state)) {
         log << "Solution found!" << endl;
         Plan plan;
@@ -134,6 +249,23 @@ void SearchEngine::add_pruning_option(OptionParser &parser) {
         "null()");
 }
 
+void SearchEngine::add_symmetries_option(OptionParser &parser) {
+    parser.add_option<shared_ptr<Group>>(
+        "symmetries",
+        "symmetries object to compute structural symmetries for pruning "
+        "with orbit space search or DKS. Note that neither works with "
+        "preferred operators and multi path search (lazy search and "
+        "enforced hill-climbing reject preferred operators together with "
+        "symmetries). Both can be combined with pruning methods such as "
+        "strong stubborn sets.",
+        OptionParser::NONE);
+    parser.add_option<string>(
+        "symmetry_statistics_file",
+        "write the search and canonicalization statistics of the search "
+        "symmetries as JSON to this file after the search",
+        OptionParser::NONE);
+}
+
 void SearchEngine::add_options_to_parser(OptionParser &parser) {
     ::add_cost_type_option_to_parser(parser);
     parser.add_option<int>(
@@ -149,6 +281,28 @@ void SearchEngine::add_options_to_parser(OptionParser &parser) {
         "experiments. Timed-out searches are treated as failed searches, "
         "just like incomplete search algorithms that exhaust their search space.",
         "infinity");
+    vector<string> state_compression;
+    vector<string> state_compression_doc;
+    state_compression.push_back("NONE");
+    state_compression_doc.push_back(
+        "store states packed by the task's state packer");
+    state_compression.push_back("TIGHT");
+    state_compression_doc.push_back(
+        "pack the values of the variables without gaps, letting them "
+        "straddle bin boundaries");
+    state_compression.push_back("DICTIONARY");
+    state_compression_doc.push_back(
+        "tightly pack the values and replace each pair of bins by its "
+        "index in a dictionary of the distinct pairs at its position "
+        "(collapse compression)");
+    parser.add_enum_option<StateCompression>(
+        "state_compression",
+        state_compression,
+        "compression of the states in the state registry. Compressed "
+        "states are unpacked whenever they are looked up, which trades "
+        "time for memory.",
+        "NONE",
+        state_compression_doc);
     utils::add_log_options_to_parser(parser);
 }
 
@@ -12,6 +12,7 @@
 
 #include "utils/logging.h"
 
+#include <string>
 #include <vector>
 
 class Group;
@@ -53,13 +54,42 @@ protected:
     OperatorCost cost_type;
     bool is_unit_cost;
     double max_time;
+    /*
+      Structural symmetries used for orbit space search (OSS) or duplicate
+      pruning with DKS. Null if the engine does not use search symmetries.
+    */
+    std::shared_ptr<Group> group;
+    // If not empty, print_symmetry_statistics also writes them to this file.
+    std::string symmetry_statistics_file;
+    /*
+      Trace of the canonicalization of the last state returned by
+      get_search_successor_state if the group records traces.
+    */
+    std::vector<int> successor_permutation_trace;
 
     virtual void initialize() {}
     virtual SearchStatus step() = 0;
 
+    bool use_oss() const;
+    bool use_dks() const;
+    /*
+      Return the initial state and successor states as they are stored in
+      the search space, i.e., their canonical representatives for OSS.
+    */
+    State get_initial_search_state();
+    State get_search_successor_state(const State &state, const OperatorProxy &op);
+    /*
+      Record the trace of the canonicalization of succ_state, which must be
+      the state returned by the last call of get_search_successor_state,
+      for plan reconstruction. Has no effect unless symmetries are used and
+      record traces.
+    */
+    void record_permutation_trace(const State &succ_state);
+    void print_symmetry_statistics() const;
+    void write_symmetry_statistics_file() const;
+
     void set_plan(const Plan &plan);
-    bool check_goal_and_set_plan(const State &state,
-                                 const std::shared_ptr<Group> &group = nullptr);
+    bool check_goal_and_set_plan(const State &state);
     int get_adjusted_cost(const OperatorProxy &op) const;
 public:
     SearchEngine(const options::Options &opts);
@@ -75,9 +105,10 @@ public:
     int get_bound() {return bound;}
     PlanManager &get_plan_manager() {return plan_manager;}
 
-    /* The following three methods should become functions as they
+    /* The following four methods should become functions as they
        do not require access to private/protected class members. */
     static void add_pruning_option(options::OptionParser &parser);
+    static void add_symmetries_option(options::OptionParser &parser);
     static void add_options_to_parser(options::OptionParser &parser);
     static void add_succ_order_options(options::OptionParser &parser);
 };
@@ -10,9 +10,10 @@
 #include "../task_utils/successor_generator.h"
 #include "../tasks/root_task.h"
 
+#include "../utils/hash.h"
 #include "../utils/logging.h"
-#include "../structural_symmetries/group.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <memory>
@@ -35,28 +36,6 @@ EagerSearch::EagerSearch(const Options &opts)
         cerr << "lazy_evaluator must cache its estimates" << endl;
         utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
     }
-    if (opts.contains("symmetries")) {
-        group = opts.get<shared_ptr<Group>>("symmetries");
-        if (group && !group->is_initialized()) {
-            utils::g_log << "Initializing symmetries (eager search)" << endl;
-            group->compute_symmetries(TaskProxy(*tasks::g_root_task));
-        }
-
-        if (use_dks()) {
-            utils::g_log << "Setting group in registry for DKS search" << endl;
-            state_registry.set_group(group);
-        }
-    } else {
-        group = nullptr;
-    }
-}
-
-bool EagerSearch::use_oss() const {
-    return group && group->has_symmetries() && group->get_search_symmetries() == SearchSymmetries::OSS;
-}
-
-bool EagerSearch::use_dks() const {
-    return group && group->has_symmetries() && group->get_search_symmetries() == SearchSymmetries::DKS;
 }
 
 void EagerSearch::initialize() {
@@ -96,11 +75,7 @@ void EagerSearch::initialize() {
 
     path_dependent_evaluators.assign(evals.begin(), evals.end());
 
-    State initial_state = state_registry.get_initial_state();
-    if (use_oss()) {
-        vector<int> canonical_state = group->get_canonical_representative(initial_state);
-        initial_state = state_registry.register_state_buffer(canonical_state);
-    }
+    State initial_state = get_initial_search_state();
     for (Evaluator *evaluator : path_dependent_evaluators) {
         evaluator->notify_initial_state(initial_state);
     }
@@ -128,12 +103,27 @@ void EagerSearch::initialize() {
     print_initial_evaluator_values(eval_context);
 
     pruning_method->initialize(task);
+    /*
+      Pruning operators and pruning symmetric states can be combined safely
+      (Wehrle et al., IJCAI 2015): we compute the pruned operators for the
+      state stored in the search space, i.e., the canonical representative
+      for OSS and the first reached state of its orbit for DKS. Symmetries
+      stabilize the goal and preserve operator costs, so all states of an
+      orbit have the same goal distance, and strong stubborn sets preserve
+      an optimal plan from every expanded state. Plans are reconstructed
+      from all applicable operators (see SearchSpace::trace_path), so they
+      do not depend on the pruning either.
+    */
+    if (use_oss() || use_dks()) {
+        pruning_method->set_report_per_orbit();
+    }
 }
 
 void EagerSearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
     pruning_method->print_statistics();
+    print_symmetry_statistics();
 }
 
 SearchStatus EagerSearch::step() {
@@ -197,7 +187,7 @@ SearchStatus EagerSearch::step() {
     }
 
     const State &s = node->get_state();
-    if (check_goal_and_set_plan(s, group))
+    if (check_goal_and_set_plan(s))
         return SOLVED;
 
     vector<OperatorID> applicable_ops;
@@ -218,26 +208,52 @@ SearchStatus EagerSearch::step() {
                                     preferred_operators);
     }
 
+    /*
+      New successors are opened right away but only evaluated and inserted
+      into the open list after all successors are generated, so that the
+      evaluators can compute their values for the whole batch at once.
+    */
+    struct NewSuccessor {
+        State state;
+        int g;
+        bool is_preferred;
+    };
+    vector<NewSuccessor> new_successors;
+    /*
+      Reopening a new successor needs its position in new_successors. For
+      large batches, we index the new successors lazily instead of
+      scanning them: the map holds the first new_successor_indices.size()
+      of them.
+    */
+    const size_t max_unindexed_new_successors = 16;
+    utils::HashMap<StateID, int> new_successor_indices;
+    auto find_new_successor = [&](StateID id) -> NewSuccessor * {
+            if (new_successors.size() <= max_unindexed_new_successors) {
+                for (NewSuccessor &successor : new_successors) {
+                    if (successor.state.get_id() == id) {
+                        return &successor;
+                    }
+                }
+                return nullptr;
+            }
+            for (size_t i = new_successor_indices.size();
+                 i < new_successors.size(); ++i) {
+                new_successor_indices.emplace(
+                    new_successors[i].state.get_id(), i);
+            }
+            auto it = new_successor_indices.find(id);
+            if (it == new_successor_indices.end()) {
+                return nullptr;
+            }
+            return &new_successors[it->second];
+        };
+
     for (OperatorID op_id : applicable_ops) {
         OperatorProxy op = task_proxy.get_operators()[op_id];
         if ((node->get_real_g() + op.get_cost()) >= bound)
             continue;
 
-        /*
-          NOTE: In orbit search tmp_registry has to survive as long as
-                succ_state is used. This could be forever, but for heuristics
-                that do not store per state information it is ok to keep it
-                only for this operator application. In regular search it is not
-                actually needed, but I don't see a way around having it there,
-                too.
-        */
-        StateRegistry tmp_registry(task_proxy);
-        StateRegistry *successor_registry = use_oss() ? &tmp_registry : &state_registry;
-        State succ_state = successor_registry->get_successor_state(s, op);
-        if (use_oss()) {
-            vector<int> canonical_state = group->get_canonical_representative(succ_state);
-            succ_state = state_registry.register_state_buffer(canonical_state);
-        }
+        State succ_state = get_search_successor_state(s, op);
         statistics.inc_generated();
         bool is_preferred = preferred_operators.contains(op_id);
 
@@ -252,39 +268,30 @@ SearchStatus EagerSearch::step() {
             continue;
 
         if (succ_node.is_new()) {
-            // We have not seen this state before.
-            // Evaluate and create a new node.
-
-            // Careful: succ_node.get_g() is not available here yet,
-            // hence the stupid computation of succ_g.
-            // TODO: Make this less fragile.
-            int succ_g = node->get_g() + get_adjusted_cost(op);
-
+            // We have not seen this state before. Create a new node.
+            succ_node.open(*node, op, get_adjusted_cost(op));
+            record_permutation_trace(succ_state);
             /*
               NOTE: previous versions used the non-canocialized successor state
               here, but this lead to problems because the EvaluationContext was
               initialized with one state and the insertion was performed with
               another state.
              */
-            EvaluationContext succ_eval_context(
-                succ_state, succ_g, is_preferred, &statistics);
-            statistics.inc_evaluated_states();
-
-            if (open_list->is_dead_end(succ_eval_context)) {
-                succ_node.mark_as_dead_end();
-                statistics.inc_dead_ends();
-                continue;
-            }
-            succ_node.open(*node, op, get_adjusted_cost(op));
-
-            open_list->insert(succ_eval_context, succ_state.get_id());
-            if (search_progress.check_progress(succ_eval_context)) {
-                statistics.print_checkpoint_line(succ_node.get_g());
-                reward_progress();
-            }
+            new_successors.push_back(
+                {succ_state, succ_node.get_g(), is_preferred});
         } else if (succ_node.get_g() > node->get_g() + get_adjusted_cost(op)) {
             // We found a new cheapest path to an open or closed state.
             if (reopen_closed_nodes) {
+                NewSuccessor *new_successor =
+                    find_new_successor(succ_state.get_id());
+                if (new_successor) {
+                    // The state was opened in this step and is not evaluated yet.
+                    succ_node.reopen(*node, op, get_adjusted_cost(op));
+                    record_permutation_trace(succ_state);
+                    new_successor->g = succ_node.get_g();
+                    new_successor->is_preferred |= is_preferred;
+                    continue;
+                }
                 if (succ_node.is_closed()) {
                     /*
                       TODO: It would be nice if we had a way to test
@@ -296,6 +303,7 @@ SearchStatus EagerSearch::step() {
                     statistics.inc_reopened();
                 }
                 succ_node.reopen(*node, op, get_adjusted_cost(op));
+                record_permutation_trace(succ_state);
 
                 EvaluationContext succ_eval_context(
                     succ_state, succ_node.get_g(), is_preferred, &statistics);
@@ -323,10 +331,37 @@ SearchStatus EagerSearch::step() {
                 // Note that this could cause an incompatibility between
                 // the g-value and the actual path that is traced back.
                 succ_node.update_parent(*node, op, get_adjusted_cost(op));
+                record_permutation_trace(succ_state);
             }
         }
     }
 
+    vector<EvaluationContext> succ_eval_contexts;
+    succ_eval_contexts.reserve(new_successors.size());
+    vector<EvaluationContext *> succ_eval_context_pointers;
+    for (const NewSuccessor &successor : new_successors) {
+        succ_eval_contexts.emplace_back(
+            successor.state, successor.g, successor.is_preferred, &statistics);
+        succ_eval_context_pointers.push_back(&succ_eval_contexts.back());
+        statistics.inc_evaluated_states();
+    }
+    open_list->evaluate_batch(succ_eval_context_pointers);
+
+    for (EvaluationContext &succ_eval_context : succ_eval_contexts) {
+        const State &succ_state = succ_eval_context.get_state();
+        SearchNode succ_node = search_space.get_node(succ_state);
+        if (open_list->is_dead_end(succ_eval_context)) {
+            succ_node.mark_as_dead_end();
+            statistics.inc_dead_ends();
+            continue;
+        }
+        open_list->insert(succ_eval_context, succ_state.get_id());
+        if (search_progress.check_progress(succ_eval_context)) {
+            statistics.print_checkpoint_line(succ_node.get_g());
+            reward_progress();
+        }
+    }
+
     return IN_PROGRESS;
 }
 
@@ -358,6 +393,7 @@ void EagerSearch::update_f_value_statistics(EvaluationContext &eval_context) {
 
 void add_options_to_parser(OptionParser &parser) {
     SearchEngine::add_pruning_option(parser);
+    SearchEngine::add_symmetries_option(parser);
     SearchEngine::add_options_to_parser(parser);
 }
 }
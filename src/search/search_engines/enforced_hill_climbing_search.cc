@@ -73,16 +73,20 @@ EnforcedHillClimbingSearch::EnforcedHillClimbingSearch(
       evaluator(opts.get<shared_ptr<Evaluator>>("h")),
       preferred_operator_evaluators(opts.get_list<shared_ptr<Evaluator>>("preferred")),
       preferred_usage(opts.get<PreferredUsage>("preferred_usage")),
-      current_eval_context(state_registry.get_initial_state(), &statistics),
+      current_eval_context(get_initial_search_state(), &statistics),
       current_phase_start_g(-1),
       num_ehc_phases(0),
       last_num_expanded(-1) {
+    if (group && !preferred_operator_evaluators.empty()) {
+        cerr << "Search symmetries do not support preferred operators." << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
     for (const shared_ptr<Evaluator> &eval : preferred_operator_evaluators) {
         eval->get_path_dependent_evaluators(path_dependent_evaluators);
     }
     evaluator->get_path_dependent_evaluators(path_dependent_evaluators);
 
-    State initial_state = state_registry.get_initial_state();
+    State initial_state = current_eval_context.get_state();
     for (Evaluator *evaluator : path_dependent_evaluators) {
         evaluator->notify_initial_state(initial_state);
     }
@@ -212,7 +216,7 @@ SearchStatus EnforcedHillClimbingSearch::ehc() {
         if (parent_node.get_real_g() + last_op.get_cost() >= bound)
             continue;
 
-        State state = state_registry.get_successor_state(parent_state, last_op);
+        State state = get_search_successor_state(parent_state, last_op);
         statistics.inc_generated();
 
         SearchNode node = search_space.get_node(state);
@@ -230,6 +234,7 @@ SearchStatus EnforcedHillClimbingSearch::ehc() {
 
             int h = eval_context.get_evaluator_value(evaluator.get());
             node.open(parent_node, last_op, get_adjusted_cost(last_op));
+            record_permutation_trace(state);
 
             if (h < current_eval_context.get_evaluator_value(evaluator.get())) {
                 ++num_ehc_phases;
@@ -271,6 +276,7 @@ void EnforcedHillClimbingSearch::print_statistics() const {
             << " - Avg. Expansions: "
             << static_cast<double>(total_expansions) / phases << endl;
     }
+    print_symmetry_statistics();
 }
 
 static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
@@ -288,6 +294,7 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
         "preferred",
         "use preferred operators of these evaluators",
         "[]");
+    SearchEngine::add_symmetries_option(parser);
     SearchEngine::add_options_to_parser(parser);
     Options opts = parser.parse();
 
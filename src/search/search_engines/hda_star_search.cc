@@ -0,0 +1,500 @@
+#include "hda_star_search.h"
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/hash.h"
+#include "../utils/logging.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <set>
+#include <thread>
+
+using namespace std;
+using utils::ExitCode;
+
+namespace hda_star_search {
+Inbox::Inbox()
+    : head(nullptr) {
+}
+
+Inbox::~Inbox() {
+    MessageBatch *batch = take_all();
+    while (batch) {
+        MessageBatch *next = batch->next;
+        delete batch;
+        batch = next;
+    }
+}
+
+void Inbox::push(MessageBatch *batch) {
+    batch->next = head.load(memory_order_relaxed);
+    while (!head.compare_exchange_weak(
+               batch->next, batch,
+               memory_order_release, memory_order_relaxed)) {
+    }
+}
+
+MessageBatch *Inbox::take_all() {
+    return head.exchange(nullptr, memory_order_acquire);
+}
+
+bool Inbox::empty() const {
+    return head.load(memory_order_relaxed) == nullptr;
+}
+
+
+Shard::Shard(HDAStarSearch &engine, int id)
+    : engine(engine),
+      id(id),
+      state_registry(engine.task_proxy),
+      outgoing_batches(engine.num_threads),
+      statistics(engine.log) {
+}
+
+void Shard::insert_state(
+    const PackedStateBin *buffer, const MessageBatch::Message &message) {
+    State state = state_registry.register_packed_state(buffer);
+    HDANode &node = nodes[state];
+    if (node.dead_end || (!node.is_new() && node.g <= message.g)) {
+        return;
+    }
+    if (node.is_new()) {
+        EvaluationContext eval_context(state, message.g, false, &statistics);
+        statistics.inc_evaluated_states();
+        if (eval_context.is_evaluator_value_infinite(evaluator.get())) {
+            node.dead_end = true;
+            statistics.inc_dead_ends();
+            return;
+        }
+        node.h = eval_context.get_evaluator_value(evaluator.get());
+    } else if (node.closed) {
+        statistics.inc_reopened();
+    }
+    node.g = message.g;
+    node.real_g = message.real_g;
+    node.closed = false;
+    node.parent_shard = message.parent_shard;
+    node.parent_id = message.parent_id;
+    node.creating_operator = message.creating_operator;
+    int f = node.g + node.h;
+    if (f < engine.best_plan_cost.load(memory_order_relaxed)) {
+        open_list.push({f, node.h, node.g, state.get_id()});
+    }
+}
+
+void Shard::process_inbox() {
+    MessageBatch *batch = inbox.take_all();
+    int num_bins = state_registry.get_state_packer().get_num_bins();
+    while (batch) {
+        const PackedStateBin *buffer = batch->state_data.data();
+        for (const MessageBatch::Message &message : batch->messages) {
+            insert_state(buffer, message);
+            buffer += num_bins;
+        }
+        MessageBatch *next = batch->next;
+        delete batch;
+        batch = next;
+        // The batch is no longer in transit.
+        engine.num_busy_threads_and_batches.fetch_sub(1);
+    }
+}
+
+void Shard::expand_next_state() {
+    OpenListEntry entry = open_list.top();
+    open_list.pop();
+    if (entry.f >= engine.best_plan_cost.load(memory_order_relaxed)) {
+        // All remaining entries have at least the same f value.
+        open_list = priority_queue<OpenListEntry>();
+        return;
+    }
+    HDANode &node = nodes[state_registry.lookup_state(entry.id)];
+    if (node.closed || node.g < entry.g) {
+        // The state was expanded or reached with a cheaper path since.
+        return;
+    }
+    State state = state_registry.lookup_state(entry.id);
+    node.closed = true;
+    statistics.inc_expanded();
+
+    if (task_properties::is_goal_state(engine.task_proxy, state)) {
+        engine.report_goal(id, entry.id, node.g);
+        return;
+    }
+
+    vector<OperatorID> applicable_ops;
+    engine.successor_generator.generate_applicable_ops(state, applicable_ops);
+    OperatorsProxy operators = engine.task_proxy.get_operators();
+    for (OperatorID op_id : applicable_ops) {
+        OperatorProxy op = operators[op_id];
+        if (node.real_g + op.get_cost() >= engine.bound) {
+            continue;
+        }
+        send_successor(state, node, op);
+    }
+}
+
+void Shard::send_successor(
+    const State &state, const HDANode &node, const OperatorProxy &op) {
+    int succ_g = node.g + engine.get_adjusted_cost(op);
+    if (succ_g >= engine.best_plan_cost.load(memory_order_relaxed)) {
+        return;
+    }
+    statistics.inc_generated();
+
+    const int_packer::IntPacker &state_packer =
+        state_registry.get_state_packer();
+    int num_bins = state_packer.get_num_bins();
+    vector<PackedStateBin> buffer(state.get_buffer(),
+                                  state.get_buffer() + num_bins);
+    for (EffectProxy effect : op.get_effects()) {
+        if (does_fire(effect, state)) {
+            FactPair effect_pair = effect.get_fact().get_pair();
+            state_packer.set(buffer.data(), effect_pair.var, effect_pair.value);
+        }
+    }
+
+    MessageBatch::Message message {
+        succ_g, node.real_g + op.get_cost(), id, state.get_id(),
+        OperatorID(op.get_id())};
+    int target = engine.get_shard(buffer.data());
+    if (target == id) {
+        insert_state(buffer.data(), message);
+    } else {
+        unique_ptr<MessageBatch> &batch = outgoing_batches[target];
+        if (!batch) {
+            batch = utils::make_unique_ptr<MessageBatch>();
+        }
+        batch->state_data.insert(
+            batch->state_data.end(), buffer.begin(), buffer.end());
+        batch->messages.push_back(message);
+    }
+}
+
+void Shard::flush_outgoing_batches() {
+    for (size_t target = 0; target < outgoing_batches.size(); ++target) {
+        unique_ptr<MessageBatch> &batch = outgoing_batches[target];
+        if (batch) {
+            // Count the batch before it is visible to the target.
+            engine.num_busy_threads_and_batches.fetch_add(1);
+            engine.shards[target]->inbox.push(batch.release());
+        }
+    }
+}
+
+bool Shard::wait_for_work() {
+    engine.num_busy_threads_and_batches.fetch_sub(1);
+    while (true) {
+        if (!inbox.empty()) {
+            /*
+              The batch in our inbox is still counted, so the counter is
+              positive and we can safely become busy again.
+            */
+            engine.num_busy_threads_and_batches.fetch_add(1);
+            return true;
+        }
+        if (engine.num_busy_threads_and_batches.load() == 0 ||
+            engine.timed_out.load(memory_order_relaxed)) {
+            return false;
+        }
+        this_thread::yield();
+    }
+}
+
+void Shard::insert_initial_state(const State &initial_state) {
+    MessageBatch::Message message {
+        0, 0, -1, StateID::no_state, OperatorID::no_operator};
+    insert_state(initial_state.get_buffer(), message);
+}
+
+void Shard::run() {
+    while (true) {
+        process_inbox();
+        if (open_list.empty()) {
+            if (!wait_for_work()) {
+                return;
+            }
+            continue;
+        }
+        expand_next_state();
+        flush_outgoing_batches();
+        if (engine.is_time_limit_reached()) {
+            engine.timed_out = true;
+        }
+        if (engine.timed_out.load(memory_order_relaxed)) {
+            engine.num_busy_threads_and_batches.fetch_sub(1);
+            return;
+        }
+    }
+}
+
+void Shard::clear_inbox() {
+    MessageBatch *batch = inbox.take_all();
+    while (batch) {
+        MessageBatch *next = batch->next;
+        delete batch;
+        batch = next;
+    }
+}
+
+const HDANode &Shard::get_node(StateID id) const {
+    return nodes[state_registry.lookup_state(id)];
+}
+
+
+HDAStarSearch::HDAStarSearch(
+    const Options &opts, options::Registry &registry,
+    const options::Predefinitions &predefinitions)
+    : SearchEngine(opts),
+      eval_config(opts.get<ParseTree>("eval")),
+      registry(registry),
+      predefinitions(predefinitions),
+      num_threads(opts.get<int>("num_threads") > 0 ?
+                  opts.get<int>("num_threads") :
+                  max(1u, thread::hardware_concurrency())),
+      max_wall_time(max_time),
+      num_busy_threads_and_batches(0),
+      best_plan_cost(numeric_limits<int>::max()),
+      timed_out(false),
+      goal_shard(-1),
+      goal_id(StateID::no_state) {
+    task_properties::verify_no_axioms(task_proxy);
+    if (group) {
+        cerr << "hdastar does not support search symmetries." << endl;
+        utils::exit_with(ExitCode::SEARCH_UNSUPPORTED);
+    }
+    // Shards exchange states as packed data of the task's state packer.
+    if (opts.get<StateCompression>("state_compression") !=
+        StateCompression::NONE) {
+        cerr << "hdastar does not support state compression." << endl;
+        utils::exit_with(ExitCode::SEARCH_UNSUPPORTED);
+    }
+
+    for (int i = 0; i < num_threads; ++i) {
+        shards.push_back(utils::make_unique_ptr<Shard>(*this, i));
+    }
+    /*
+      We check the time limit ourselves, so the CPU time limit of the
+      base class must not end the search.
+    */
+    max_time = numeric_limits<double>::infinity();
+}
+
+HDAStarSearch::~HDAStarSearch() {
+}
+
+shared_ptr<Evaluator> HDAStarSearch::create_evaluator() {
+    OptionParser parser(eval_config, registry, predefinitions, false);
+    return parser.start_parsing<shared_ptr<Evaluator>>();
+}
+
+void HDAStarSearch::create_evaluators() {
+    /*
+      Evaluators are not thread-safe, so every thread needs its own. We
+      build them one after another since evaluator constructors fill
+      global caches without locking (e.g., the causal graph cache).
+    */
+    for (const unique_ptr<Shard> &shard : shards) {
+        shard->evaluator = create_evaluator();
+    }
+
+    /*
+      Evaluators must not depend on the path since parents and successors
+      live in different shards.
+    */
+    set<Evaluator *> evaluators;
+    for (const unique_ptr<Shard> &shard : shards) {
+        set<Evaluator *> path_dependent_evaluators;
+        shard->evaluator->get_path_dependent_evaluators(
+            path_dependent_evaluators);
+        if (!path_dependent_evaluators.empty()) {
+            cerr << "hdastar does not support path-dependent evaluators."
+                 << endl;
+            utils::exit_with(ExitCode::SEARCH_UNSUPPORTED);
+        }
+        if (!evaluators.insert(shard->evaluator.get()).second) {
+            cerr << "hdastar needs one evaluator per thread and thus "
+                 << "does not support predefined evaluators." << endl;
+            utils::exit_with(ExitCode::SEARCH_UNSUPPORTED);
+        }
+    }
+}
+
+bool HDAStarSearch::is_time_limit_reached() const {
+    return max_wall_time != numeric_limits<double>::infinity() &&
+           chrono::steady_clock::now() >= deadline;
+}
+
+int HDAStarSearch::get_shard(const PackedStateBin *buffer) const {
+    int num_bins = state_registry.get_state_packer().get_num_bins();
+    utils::HashState hash_state;
+    for (int i = 0; i < num_bins; ++i) {
+        hash_state.feed(buffer[i]);
+    }
+    /*
+      The state registries use the lower 32 bits of this hash, so we use
+      the upper ones to avoid correlation with their hash buckets.
+    */
+    return (hash_state.get_hash64() >> 32) % num_threads;
+}
+
+void HDAStarSearch::report_goal(int shard, StateID id, int g) {
+    lock_guard<mutex> lock(goal_mutex);
+    if (g < best_plan_cost.load()) {
+        best_plan_cost = g;
+        goal_shard = shard;
+        goal_id = id;
+    }
+}
+
+void HDAStarSearch::trace_plan(Plan &plan) const {
+    assert(plan.empty());
+    int shard = goal_shard;
+    StateID id = goal_id;
+    while (true) {
+        const HDANode &node = shards[shard]->get_node(id);
+        if (node.creating_operator == OperatorID::no_operator) {
+            assert(node.parent_shard == -1);
+            break;
+        }
+        plan.push_back(node.creating_operator);
+        shard = node.parent_shard;
+        id = node.parent_id;
+    }
+    reverse(plan.begin(), plan.end());
+}
+
+void HDAStarSearch::initialize() {
+    log << "Conducting hash-distributed A* search with " << num_threads
+        << " threads, (real) bound = " << bound << endl;
+    if (max_wall_time != numeric_limits<double>::infinity()) {
+        deadline = chrono::steady_clock::now() +
+            chrono::duration_cast<chrono::steady_clock::duration>(
+                chrono::duration<double>(max_wall_time));
+    }
+    create_evaluators();
+    if (is_time_limit_reached()) {
+        timed_out = true;
+    }
+    State initial_state = state_registry.get_initial_state();
+    shards[get_shard(initial_state.get_buffer())]->insert_initial_state(
+        initial_state);
+}
+
+SearchStatus HDAStarSearch::step() {
+    num_busy_threads_and_batches = num_threads;
+    vector<thread> threads;
+    for (const unique_ptr<Shard> &shard : shards) {
+        threads.emplace_back(&Shard::run, shard.get());
+    }
+    for (thread &thread : threads) {
+        thread.join();
+    }
+    for (const unique_ptr<Shard> &shard : shards) {
+        // After a timeout, batches can be left in the inboxes.
+        shard->clear_inbox();
+        const SearchStatistics &shard_statistics = shard->get_statistics();
+        statistics.inc_expanded(shard_statistics.get_expanded());
+        statistics.inc_evaluated_states(
+            shard_statistics.get_evaluated_states());
+        statistics.inc_evaluations(shard_statistics.get_evaluations());
+        statistics.inc_generated(shard_statistics.get_generated());
+        statistics.inc_reopened(shard_statistics.get_reopened());
+        statistics.inc_dead_ends(shard_statistics.get_dead_ends());
+    }
+
+    if (goal_id == StateID::no_state) {
+        if (timed_out) {
+            log << "Time limit reached. Abort search." << endl;
+            return TIMEOUT;
+        }
+        log << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+    if (timed_out) {
+        log << "Time limit reached, plan is not proven optimal." << endl;
+    }
+    log << "Solution found!" << endl;
+    Plan plan;
+    trace_plan(plan);
+    set_plan(plan);
+    return SOLVED;
+}
+
+void HDAStarSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    for (size_t i = 0; i < shards.size(); ++i) {
+        log << "Shard " << i << ": "
+            << shards[i]->get_statistics().get_expanded()
+            << " expanded state(s), "
+            << shards[i]->state_registry.size() << " registered state(s)"
+            << endl;
+    }
+}
+
+static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Hash-distributed A* search",
+        "A* search parallelized by distributing states to threads by their "
+        "hash (Kishimoto et al., 2009). Every thread expands the states it "
+        "owns in order of their f values and sends successors owned by other "
+        "threads in batches to lock-free inboxes. The search terminates when "
+        "all threads are idle and no batch is in transit, so with an "
+        "admissible heuristic the plan is optimal.");
+    parser.document_note(
+        "Evaluators",
+        "Every thread creates its own evaluator from the configuration, so "
+        "predefined evaluators are not supported, and it must not be "
+        "path-dependent.");
+    parser.document_note(
+        "Memory",
+        "Every thread has its own stack and malloc arena, which count "
+        "towards the address-space limit set by the driver's memory limits. "
+        "With many threads, this can use up the memory limit before the "
+        "search starts (e.g., eight threads can take several hundred MB of "
+        "address space before the first expansion).");
+    parser.document_note(
+        "Time limit",
+        "Unlike for other search engines, max_time is measured in wall-clock "
+        "time since the search started, including the time for creating "
+        "the evaluators.");
+    parser.document_language_support("action costs", "supported");
+    parser.document_language_support("conditional effects", "supported");
+    parser.document_language_support("axioms", "not supported");
+    parser.document_property("admissible", "yes if the evaluator is admissible");
+    parser.document_property("optimal", "yes if the evaluator is admissible");
+
+    parser.add_option<ParseTree>("eval", "evaluator for h-value");
+    parser.add_option<int>(
+        "num_threads",
+        "number of threads (0 uses the number of hardware threads; see the "
+        "note on memory)",
+        "1",
+        Bounds("0", "infinity"));
+    SearchEngine::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    if (parser.help_mode()) {
+        return nullptr;
+    } else if (parser.dry_run()) {
+        // Check if the supplied evaluator can be parsed.
+        OptionParser test_parser(opts.get<ParseTree>("eval"),
+                                 parser.get_registry(),
+                                 parser.get_predefinitions(), true);
+        test_parser.start_parsing<shared_ptr<Evaluator>>();
+        return nullptr;
+    } else {
+        return make_shared<HDAStarSearch>(opts, parser.get_registry(),
+                                          parser.get_predefinitions());
+    }
+}
+
+static Plugin<SearchEngine> _plugin("hdastar", _parse);
+}
@@ -0,0 +1,202 @@
+#ifndef SEARCH_ENGINES_HDA_STAR_SEARCH_H
+#define SEARCH_ENGINES_HDA_STAR_SEARCH_H
+
+#include "../option_parser_util.h"
+#include "../per_state_information.h"
+#include "../search_engine.h"
+
+#include "../options/predefinitions.h"
+#include "../options/registries.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+class Evaluator;
+
+namespace options {
+class Options;
+}
+
+namespace hda_star_search {
+class HDAStarSearch;
+
+/*
+  Search information for a state in the shard that owns it. Parents can
+  live in other shards, so we store the parent's shard together with its
+  id in that shard's registry.
+*/
+struct HDANode {
+    int g;
+    int real_g;
+    int h;
+    bool closed;
+    bool dead_end;
+    int parent_shard;
+    StateID parent_id;
+    OperatorID creating_operator;
+
+    HDANode()
+        : g(-1),
+          real_g(-1),
+          h(-1),
+          closed(false),
+          dead_end(false),
+          parent_shard(-1),
+          parent_id(StateID::no_state),
+          creating_operator(OperatorID::no_operator) {
+    }
+
+    bool is_new() const {
+        return g == -1;
+    }
+};
+
+// Successor states sent to another shard, together with their search data.
+struct MessageBatch {
+    struct Message {
+        int g;
+        int real_g;
+        int parent_shard;
+        StateID parent_id;
+        OperatorID creating_operator;
+    };
+
+    MessageBatch *next = nullptr;
+    // Packed state data of all messages, one state after the other.
+    std::vector<PackedStateBin> state_data;
+    std::vector<Message> messages;
+};
+
+/*
+  Lock-free inbox of a shard: any thread can push batches with a CAS on
+  the head of a linked list (a Treiber stack), and only the owning
+  thread takes all batches at once. Since nodes are never popped
+  individually, the ABA problem cannot occur.
+*/
+class Inbox {
+    std::atomic<MessageBatch *> head;
+public:
+    Inbox();
+    ~Inbox();
+    void push(MessageBatch *batch);
+    MessageBatch *take_all();
+    bool empty() const;
+};
+
+/*
+  A shard owns the states whose hash maps to it: they are only
+  registered, evaluated and expanded by the thread of this shard, so
+  the shard does not need any synchronization except for its inbox.
+*/
+class Shard {
+    struct OpenListEntry {
+        int f;
+        int h;
+        int g;
+        StateID id;
+
+        // Order for std::priority_queue: smallest f first, ties by h.
+        bool operator<(const OpenListEntry &other) const {
+            if (f != other.f) {
+                return f > other.f;
+            }
+            return h > other.h;
+        }
+    };
+
+    HDAStarSearch &engine;
+    const int id;
+    std::shared_ptr<Evaluator> evaluator;
+    StateRegistry state_registry;
+    PerStateInformation<HDANode> nodes;
+    std::priority_queue<OpenListEntry> open_list;
+    std::vector<std::unique_ptr<MessageBatch>> outgoing_batches;
+    SearchStatistics statistics;
+    Inbox inbox;
+
+    void insert_state(
+        const PackedStateBin *buffer, const MessageBatch::Message &message);
+    void process_inbox();
+    void expand_next_state();
+    void send_successor(
+        const State &state, const HDANode &node, const OperatorProxy &op);
+    void flush_outgoing_batches();
+    bool wait_for_work();
+public:
+    Shard(HDAStarSearch &engine, int id);
+
+    void insert_initial_state(const State &initial_state);
+    void run();
+    // The following methods may only be called if no thread is running.
+    void clear_inbox();
+    const HDANode &get_node(StateID id) const;
+    const SearchStatistics &get_statistics() const {
+        return statistics;
+    }
+
+    friend class HDAStarSearch;
+};
+
+/*
+  Hash-distributed A* (Kishimoto et al., 2009): every thread owns a shard
+  of the state space chosen by hashing the packed state data. Successors
+  owned by other shards are sent to their inboxes in batches.
+
+  The search terminates when all threads are idle and no batch is in
+  transit, which we detect with a single counter of busy threads plus
+  batches in transit: a thread only increments it while the counter is
+  positive (because the thread is busy or a batch for it is in transit),
+  so once the counter reaches zero, it stays zero. States whose f value
+  is not below the cost of the best plan found so far are pruned, so with
+  an admissible heuristic, the best plan is optimal at termination.
+*/
+class HDAStarSearch : public SearchEngine {
+    const options::ParseTree eval_config;
+    /*
+      We need to copy the registry and predefinitions here since they live
+      longer than the objects referenced in the constructor.
+    */
+    options::Registry registry;
+    options::Predefinitions predefinitions;
+    const int num_threads;
+    /*
+      The time limit of this engine is measured in wall-clock time since
+      the CPU time of the process grows with the number of threads.
+    */
+    const double max_wall_time;
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic<int> num_busy_threads_and_batches;
+    std::atomic<int> best_plan_cost;
+    std::atomic<bool> timed_out;
+    std::chrono::steady_clock::time_point deadline;
+    // Protects goal_shard and goal_id.
+    std::mutex goal_mutex;
+    int goal_shard;
+    StateID goal_id;
+
+    std::shared_ptr<Evaluator> create_evaluator();
+    void create_evaluators();
+    bool is_time_limit_reached() const;
+    int get_shard(const PackedStateBin *buffer) const;
+    void report_goal(int shard, StateID id, int g);
+    void trace_plan(Plan &plan) const;
+
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+    friend class Shard;
+public:
+    HDAStarSearch(const options::Options &opts, options::Registry &registry,
+                  const options::Predefinitions &predefinitions);
+    virtual ~HDAStarSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include "../utils/logging.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
+#include "../utils/system.h"
 
 #include <algorithm>
 #include <limits>
@@ -25,7 +26,7 @@ LazySearch::LazySearch(const Options &opts)
       randomize_successors(opts.get<bool>("randomize_successors")),
       preferred_successors_first(opts.get<bool>("preferred_successors_first")),
       rng(utils::parse_rng_from_options(opts)),
-      current_state(state_registry.get_initial_state()),
+      current_state(get_initial_search_state()),
       current_predecessor_id(StateID::no_state),
       current_operator_id(OperatorID::no_operator),
       current_g(0),
@@ -35,6 +36,10 @@ LazySearch::LazySearch(const Options &opts)
       We initialize current_eval_context in such a way that the initial node
       counts as "preferred".
     */
+    if (group && !opts.get_list<shared_ptr<Evaluator>>("preferred").empty()) {
+        cerr << "Search symmetries do not support preferred operators." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
 }
 
 void LazySearch::set_preferred_operator_evaluators(
@@ -56,9 +61,8 @@ void LazySearch::initialize() {
     }
 
     path_dependent_evaluators.assign(evals.begin(), evals.end());
-    State initial_state = state_registry.get_initial_state();
     for (Evaluator *evaluator : path_dependent_evaluators) {
-        evaluator->notify_initial_state(initial_state);
+        evaluator->notify_initial_state(current_state);
     }
 }
 
@@ -128,7 +132,7 @@ SearchStatus LazySearch::fetch_next_state() {
     State current_predecessor = state_registry.lookup_state(current_predecessor_id);
     OperatorProxy current_operator = task_proxy.get_operators()[current_operator_id];
     assert(task_properties::is_applicable(current_operator, current_predecessor));
-    current_state = state_registry.get_successor_state(current_predecessor, current_operator);
+    current_state = get_search_successor_state(current_predecessor, current_operator);
 
     SearchNode pred_node = search_space.get_node(current_predecessor);
     current_g = pred_node.get_g() + get_adjusted_cost(current_operator);
@@ -187,6 +191,7 @@ SearchStatus LazySearch::step() {
                 } else {
                     node.open(parent_node, current_operator, get_adjusted_cost(current_operator));
                 }
+                record_permutation_trace(current_state);
             }
             node.close();
             if (check_goal_and_set_plan(current_state))
@@ -215,5 +220,6 @@ void LazySearch::reward_progress() {
 void LazySearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
+    print_symmetry_statistics();
 }
 }
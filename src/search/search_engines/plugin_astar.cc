@@ -4,8 +4,6 @@
 #include "../option_parser.h"
 #include "../plugin.h"
 
-#include "../structural_symmetries/group.h"
-
 using namespace std;
 
 namespace plugin_astar {
@@ -36,22 +34,10 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
         OptionParser::NONE);
 
     eager_search::add_options_to_parser(parser);
-    parser.add_option<shared_ptr<Group>>(
-        "symmetries",
-        "symmetries object to compute structural symmetries for pruning",
-        OptionParser::NONE);
     Options opts = parser.parse();
 
     shared_ptr<eager_search::EagerSearch> engine;
     if (!parser.dry_run()) {
-        if (opts.contains("symmetries")) {
-            shared_ptr<Group> group = opts.get<shared_ptr<Group>>("symmetries");
-            if (group->get_search_symmetries() == SearchSymmetries::NONE) {
-                cerr << "Symmetries option passed to eager search, but no "
-                     << "search symmetries should be used." << endl;
-                utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
-            }
-        }
         auto temp = search_common::create_astar_open_list_factory_and_f_eval(opts);
         opts.set("open", temp.first);
         opts.set("f_eval", temp.second);
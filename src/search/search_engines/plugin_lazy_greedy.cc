@@ -58,6 +58,7 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
         "to preferred operator nodes",
         DEFAULT_LAZY_BOOST);
     SearchEngine::add_succ_order_options(parser);
+    SearchEngine::add_symmetries_option(parser);
     SearchEngine::add_options_to_parser(parser);
     Options opts = parser.parse();
 
@@ -11,6 +11,7 @@
 
 #include "utils/logging.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -123,19 +124,43 @@ void SearchNode::dump(const TaskProxy &task_proxy, utils::LogProxy &log) const {
 }
 
 SearchSpace::SearchSpace(StateRegistry &state_registry, utils::LogProxy &log)
-    : state_registry(state_registry), log(log) {
+    : permutation_trace_ids(-1), state_registry(state_registry), log(log) {
 }
 
 SearchNode SearchSpace::get_node(const State &state) {
     return SearchNode(state, search_node_infos[state]);
 }
 
+void SearchSpace::set_permutation_trace(const State &state, vector<int> &&permutation_trace) {
+    auto it = permutation_trace_ids_by_trace.find(permutation_trace);
+    if (it != permutation_trace_ids_by_trace.end()) {
+        permutation_trace_ids[state] = it->second;
+        return;
+    }
+    int trace_id = permutation_traces.size();
+    permutation_trace_ids_by_trace[permutation_trace] = trace_id;
+    permutation_traces.push_back(move(permutation_trace));
+    permutation_trace_ids[state] = trace_id;
+}
+
 void SearchSpace::trace_path(const State &goal_state,
                              vector<OperatorID> &path,
                              const shared_ptr<AbstractTask> &task,
                              const shared_ptr<Group> &group) const {
     if (group && group->has_symmetries()) {
+        group->start_path_tracing_timer();
+        if (group->records_traces() &&
+            trace_path_with_recorded_traces(goal_state, path, task, *group)) {
+            group->stop_path_tracing_timer();
+            return;
+        }
+        if (group->records_traces()) {
+            log << "Recorded traces do not suffice to reconstruct the plan, "
+                << "generating successor states instead." << endl;
+        }
+        path.clear();
         trace_path_with_symmetries(goal_state, path, task, group);
+        group->stop_path_tracing_timer();
         return;
     }
     State current_state = goal_state;
@@ -153,6 +178,125 @@ void SearchSpace::trace_path(const State &goal_state,
     reverse(path.begin(), path.end());
 }
 
+/*
+  Facts of the preconditions and effects (with their conditions) of op, as
+  indices of the group, mapped by permutation if given. Operators are
+  identified by this signature, so the order of the facts does not matter.
+*/
+static vector<int> compute_operator_signature(
+    const OperatorProxy &op, const Group &group, const RawPermutation *permutation) {
+    auto get_index = [&](const FactProxy &fact) {
+        FactPair fact_pair = fact.get_pair();
+        int index = group.get_index_by_var_val_pair(fact_pair.var, fact_pair.value);
+        return permutation ? (*permutation)[index] : index;
+    };
+    vector<int> preconditions;
+    for (FactProxy fact : op.get_preconditions()) {
+        preconditions.push_back(get_index(fact));
+    }
+    sort(preconditions.begin(), preconditions.end());
+    vector<vector<int>> effects;
+    for (EffectProxy effect : op.get_effects()) {
+        vector<int> conditions;
+        for (FactProxy fact : effect.get_conditions()) {
+            conditions.push_back(get_index(fact));
+        }
+        sort(conditions.begin(), conditions.end());
+        // The effect fact comes first to separate it from the conditions.
+        conditions.insert(conditions.begin(), get_index(effect.get_fact()));
+        effects.push_back(move(conditions));
+    }
+    sort(effects.begin(), effects.end());
+
+    vector<int> signature;
+    signature.push_back(preconditions.size());
+    signature.insert(signature.end(), preconditions.begin(), preconditions.end());
+    for (const vector<int> &effect : effects) {
+        signature.push_back(effect.size());
+        signature.insert(signature.end(), effect.begin(), effect.end());
+    }
+    return signature;
+}
+
+bool SearchSpace::trace_path_with_recorded_traces(const State &goal_state,
+                                                  vector<OperatorID> &path,
+                                                  const shared_ptr<AbstractTask> &task,
+                                                  const Group &group) const {
+    assert(path.empty());
+    TaskProxy task_proxy(*task);
+    OperatorsProxy operators = task_proxy.get_operators();
+
+    vector<State> state_trace;
+    vector<OperatorID> operator_trace;
+    State current_state = goal_state;
+    while (true) {
+        const SearchNodeInfo &info = search_node_infos[current_state];
+        assert(info.status != SearchNodeInfo::NEW);
+        state_trace.push_back(current_state);
+        if (info.creating_operator == OperatorID::no_operator)
+            break;
+        operator_trace.push_back(info.creating_operator);
+        current_state = state_registry.lookup_state(info.parent_state_id);
+    }
+
+    utils::HashMap<vector<int>, OperatorID> operators_by_signature;
+    for (OperatorProxy op : operators) {
+        vector<int> signature = compute_operator_signature(op, group, nullptr);
+        auto it = operators_by_signature.find(signature);
+        if (it == operators_by_signature.end()) {
+            operators_by_signature.emplace(move(signature), OperatorID(op.get_id()));
+        } else if (op.get_cost() < operators[it->second].get_cost()) {
+            it->second = OperatorID(op.get_id());
+        }
+    }
+
+    /*
+      to_plan_state maps the registered state of the current node to the
+      state that the plan reaches at this node. In OSS, the initial node
+      stores the canonical representative of the initial state; in DKS, it
+      stores the initial state itself.
+    */
+    bool uses_dks = group.get_search_symmetries() == SearchSymmetries::DKS;
+    RawPermutation to_plan_state = group.new_identity_raw_permutation();
+    if (!uses_dks) {
+        to_plan_state = group.compute_inverse_permutation(
+            group.compute_permutation_from_trace(
+                group.compute_permutation_trace_to_canonical_representative(
+                    task_proxy.get_initial_state())));
+    }
+    for (int i = state_trace.size() - 1; i > 0; --i) {
+        const State &state = state_trace[i - 1];
+        int trace_id = permutation_trace_ids[state];
+        if (trace_id == -1) {
+            return false;
+        }
+        /*
+          to_state maps the state generated by the creating operator from
+          the registered parent state to the registered state. In DKS, the
+          registered state is not the canonical representative.
+        */
+        RawPermutation to_state = group.compute_permutation_from_trace(
+            permutation_traces[trace_id]);
+        if (uses_dks) {
+            to_state = group.compose_permutations(
+                to_state,
+                group.compute_inverse_permutation(
+                    group.compute_permutation_from_trace(
+                        group.compute_permutation_trace_to_canonical_representative(state))));
+        }
+        OperatorProxy op = operators[operator_trace[i - 1]];
+        auto it = operators_by_signature.find(
+            compute_operator_signature(op, group, &to_plan_state));
+        if (it == operators_by_signature.end()) {
+            return false;
+        }
+        path.push_back(it->second);
+        to_plan_state = group.compose_permutations(
+            group.compute_inverse_permutation(to_state), to_plan_state);
+    }
+    return true;
+}
+
 void SearchSpace::trace_path_with_symmetries(const State &goal_state,
                                              vector<OperatorID> &path,
                                              const shared_ptr<AbstractTask> &task,
@@ -192,7 +336,19 @@ void SearchSpace::trace_path_with_symmetries(const State &goal_state,
         }
         RawPermutation p;
         if (new_state.get_id() != current_state.get_id()){
-            p = group->create_permutation_from_state_to_state(current_state, new_state);
+            if (op_id != OperatorID::no_operator &&
+                group->get_search_symmetries() == SearchSymmetries::OSS &&
+                group->uses_incremental_canonicalization()) {
+                /*
+                  current_state is the incremental canonical representative
+                  of new_state, which need not be the one that
+                  create_permutation_from_state_to_state relies on.
+                */
+                p = group->create_permutation_from_canonical_successor(
+                    new_state, operators[op_id]);
+            } else {
+                p = group->create_permutation_from_state_to_state(current_state, new_state);
+            }
         } else {
             p = group->new_identity_raw_permutation();
         }
@@ -5,6 +5,8 @@
 #include "per_state_information.h"
 #include "search_node_info.h"
 
+#include "utils/hash.h"
+
 #include <vector>
 
 class Group;
@@ -51,6 +53,15 @@ public:
 
 class SearchSpace {
     PerStateInformation<SearchNodeInfo> search_node_infos;
+    /*
+      Used for symmetries with recorded traces: for every node, the id of the
+      trace that maps the state generated by its creating operator to the
+      representative used by the state registry. Distinct traces are stored
+      only once.
+    */
+    PerStateInformation<int> permutation_trace_ids;
+    std::vector<std::vector<int>> permutation_traces;
+    utils::HashMap<std::vector<int>, int> permutation_trace_ids_by_trace;
 
     StateRegistry &state_registry;
     utils::LogProxy &log;
@@ -59,10 +70,21 @@ class SearchSpace {
                                     std::vector<OperatorID> &path,
                                     const std::shared_ptr<AbstractTask> &task,
                                     const std::shared_ptr<Group> &group) const;
+    /*
+      Reconstruct the plan from the recorded traces without generating
+      successor states. Returns false if this is not possible, e.g., because
+      a node has no recorded trace.
+    */
+    bool trace_path_with_recorded_traces(const State &goal_state,
+                                         std::vector<OperatorID> &path,
+                                         const std::shared_ptr<AbstractTask> &task,
+                                         const Group &group) const;
 public:
     SearchSpace(StateRegistry &state_registry, utils::LogProxy &log);
 
     SearchNode get_node(const State &state);
+    // Used for symmetries with recorded traces
+    void set_permutation_trace(const State &state, std::vector<int> &&permutation_trace);
     void trace_path(const State &goal_state,
                     std::vector<OperatorID> &path,
                     const std::shared_ptr<AbstractTask> &task,
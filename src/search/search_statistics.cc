@@ -18,6 +18,7 @@ SearchStatistics::SearchStatistics(utils::LogProxy &log)
     generated_states = 0;
     dead_end_states = 0;
     generated_ops = 0;
+    symmetric_duplicates = 0;
 
     lastjump_expanded_states = 0;
     lastjump_reopened_states = 0;
@@ -70,6 +71,10 @@ void SearchStatistics::print_detailed_statistics() const {
     log << "Evaluations: " << evaluations << endl;
     log << "Generated " << generated_states << " state(s)." << endl;
     log << "Dead ends: " << dead_end_states << " state(s)." << endl;
+    if (symmetric_duplicates > 0) {
+        log << "Symmetric duplicates: " << symmetric_duplicates
+            << " state(s)." << endl;
+    }
 
     if (lastjump_f_value >= 0) {
         log << "Expanded until last jump: "
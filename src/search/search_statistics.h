@@ -25,6 +25,8 @@ class SearchStatistics {
     int dead_end_states;
 
     int generated_ops;    // no of operators that were returned as applicable
+    // no of duplicates that are only detected as symmetric to a known state
+    long long symmetric_duplicates;
 
     // Statistics related to f values
     int lastjump_f_value; //f value obtained in the last jump
@@ -46,6 +48,7 @@ public:
     void inc_generated_ops(int inc = 1) {generated_ops += inc;}
     void inc_evaluations(int inc = 1) {evaluations += inc;}
     void inc_dead_ends(int inc = 1) {dead_end_states += inc;}
+    void inc_symmetric_duplicates(long long inc = 1) {symmetric_duplicates += inc;}
 
     // Methods that access statistics.
     int get_expanded() const {return expanded_states;}
@@ -54,6 +57,8 @@ public:
     int get_generated() const {return generated_states;}
     int get_reopened() const {return reopened_states;}
     int get_generated_ops() const {return generated_ops;}
+    int get_dead_ends() const {return dead_end_states;}
+    long long get_symmetric_duplicates() const {return symmetric_duplicates;}
 
     /*
       Call the following method with the f value of every expanded
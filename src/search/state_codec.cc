@@ -0,0 +1,179 @@
+#include "state_codec.h"
+
+#include "task_proxy.h"
+
+#include "utils/hash.h"
+#include "utils/logging.h"
+#include "utils/memory.h"
+#include "utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+using namespace std;
+
+namespace state_codec {
+static const int BITS_PER_BIN = sizeof(Bin) * 8;
+
+static int get_bit_size_for_range(int range) {
+    int num_bits = 0;
+    while ((1U << num_bits) < static_cast<unsigned int>(range))
+        ++num_bits;
+    return num_bits;
+}
+
+double StateCodec::get_bytes_per_state(int) const {
+    return get_num_bins() * sizeof(Bin);
+}
+
+void StateCodec::print_statistics(utils::LogProxy &) const {
+}
+
+
+TightPackingCodec::TightPackingCodec(const TaskProxy &task_proxy) {
+    int num_bits = 0;
+    for (VariableProxy var : task_proxy.get_variables()) {
+        int var_bits = get_bit_size_for_range(var.get_domain_size());
+        var_infos.push_back(
+            {num_bits / BITS_PER_BIN, num_bits % BITS_PER_BIN, var_bits});
+        num_bits += var_bits;
+    }
+    // Segmented array vectors need at least one element per array.
+    num_bins = max(1, (num_bits + BITS_PER_BIN - 1) / BITS_PER_BIN);
+}
+
+int TightPackingCodec::get_num_bins() const {
+    return num_bins;
+}
+
+void TightPackingCodec::encode(const vector<int> &values, Bin *buffer) {
+    fill_n(buffer, num_bins, 0);
+    for (size_t var = 0; var < var_infos.size(); ++var) {
+        const VariableInfo &info = var_infos[var];
+        Bin value = values[var];
+        buffer[info.bin] |= value << info.shift;
+        // Write the bits that do not fit into the bin to the next one.
+        if (info.shift + info.num_bits > BITS_PER_BIN) {
+            buffer[info.bin + 1] |= value >> (BITS_PER_BIN - info.shift);
+        }
+    }
+}
+
+void TightPackingCodec::decode(const Bin *buffer, vector<int> &values) const {
+    for (size_t var = 0; var < var_infos.size(); ++var) {
+        const VariableInfo &info = var_infos[var];
+        uint64_t bits = buffer[info.bin];
+        if (info.shift + info.num_bits > BITS_PER_BIN) {
+            bits |= static_cast<uint64_t>(buffer[info.bin + 1]) << BITS_PER_BIN;
+        }
+        uint64_t mask = (uint64_t(1) << info.num_bits) - 1;
+        values[var] = static_cast<int>((bits >> info.shift) & mask);
+    }
+}
+
+
+int_hash_set::HashType DictionaryCodec::ChunkHash::operator()(int id) const {
+    const Bin *chunk = chunks[id];
+    utils::HashState hash_state;
+    for (int i = 0; i < CHUNK_SIZE; ++i) {
+        hash_state.feed(chunk[i]);
+    }
+    return hash_state.get_hash32();
+}
+
+bool DictionaryCodec::ChunkEqual::operator()(int lhs, int rhs) const {
+    const Bin *lhs_chunk = chunks[lhs];
+    return equal(lhs_chunk, lhs_chunk + CHUNK_SIZE, chunks[rhs]);
+}
+
+DictionaryCodec::Dictionary::Dictionary()
+    : chunks(CHUNK_SIZE),
+      chunk_ids(ChunkHash(chunks), ChunkEqual(chunks)) {
+}
+
+int DictionaryCodec::Dictionary::insert(const Bin *chunk) {
+    // Same scheme as in StateRegistry: push the chunk and pop duplicates.
+    chunks.push_back(chunk);
+    pair<int, bool> result = chunk_ids.insert(chunks.size() - 1);
+    if (!result.second) {
+        chunks.pop_back();
+    }
+    return result.first;
+}
+
+DictionaryCodec::DictionaryCodec(const TaskProxy &task_proxy)
+    : packing_codec(task_proxy) {
+    int num_packed_bins = packing_codec.get_num_bins();
+    for (int i = 0; i < num_packed_bins / CHUNK_SIZE; ++i) {
+        dictionaries.push_back(utils::make_unique_ptr<Dictionary>());
+    }
+    num_bins = dictionaries.size() + num_packed_bins % CHUNK_SIZE;
+    packed_buffer.resize(num_packed_bins);
+}
+
+int DictionaryCodec::get_num_bins() const {
+    return num_bins;
+}
+
+void DictionaryCodec::encode(const vector<int> &values, Bin *buffer) {
+    packing_codec.encode(values, packed_buffer.data());
+    int num_chunks = dictionaries.size();
+    for (int i = 0; i < num_chunks; ++i) {
+        buffer[i] = dictionaries[i]->insert(&packed_buffer[i * CHUNK_SIZE]);
+    }
+    copy(packed_buffer.begin() + num_chunks * CHUNK_SIZE, packed_buffer.end(),
+         buffer + num_chunks);
+}
+
+void DictionaryCodec::decode(const Bin *buffer, vector<int> &values) const {
+    int num_chunks = dictionaries.size();
+    for (int i = 0; i < num_chunks; ++i) {
+        const Bin *chunk = dictionaries[i]->chunks[buffer[i]];
+        copy(chunk, chunk + CHUNK_SIZE, &packed_buffer[i * CHUNK_SIZE]);
+    }
+    copy(buffer + num_chunks, buffer + num_bins,
+         packed_buffer.begin() + num_chunks * CHUNK_SIZE);
+    packing_codec.decode(packed_buffer.data(), values);
+}
+
+double DictionaryCodec::get_bytes_per_state(int num_states) const {
+    // The hash sets of the dictionaries are not included.
+    double bytes = StateCodec::get_bytes_per_state(num_states);
+    if (num_states > 0) {
+        size_t num_chunks = 0;
+        for (const auto &dictionary : dictionaries) {
+            num_chunks += dictionary->chunks.size();
+        }
+        bytes += static_cast<double>(
+            num_chunks * CHUNK_SIZE * sizeof(Bin)) / num_states;
+    }
+    return bytes;
+}
+
+void DictionaryCodec::print_statistics(utils::LogProxy &log) const {
+    size_t num_chunks = 0;
+    size_t max_chunks = 0;
+    for (const auto &dictionary : dictionaries) {
+        num_chunks += dictionary->chunks.size();
+        max_chunks = max(max_chunks, dictionary->chunks.size());
+    }
+    log << "Distinct state chunks: " << num_chunks
+        << " (at most " << max_chunks << " per position)" << endl;
+}
+
+
+unique_ptr<StateCodec> create_state_codec(
+    StateCompression compression, const TaskProxy &task_proxy) {
+    switch (compression) {
+    case StateCompression::NONE:
+        return nullptr;
+    case StateCompression::TIGHT:
+        return utils::make_unique_ptr<TightPackingCodec>(task_proxy);
+    case StateCompression::DICTIONARY:
+        return utils::make_unique_ptr<DictionaryCodec>(task_proxy);
+    default:
+        ABORT("Unknown state compression");
+    }
+}
+}
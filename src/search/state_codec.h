@@ -0,0 +1,130 @@
+#ifndef STATE_CODEC_H
+#define STATE_CODEC_H
+
+#include "algorithms/int_hash_set.h"
+#include "algorithms/int_packer.h"
+#include "algorithms/segmented_vector.h"
+
+#include <memory>
+#include <vector>
+
+class TaskProxy;
+
+namespace utils {
+class LogProxy;
+}
+
+enum class StateCompression {
+    NONE,
+    TIGHT,
+    DICTIONARY
+};
+
+namespace state_codec {
+using Bin = int_packer::IntPacker::Bin;
+
+/*
+  Encodes the values of a state as a fixed number of bins. A state
+  registry with a codec stores and compares states only in encoded form,
+  so encodings must be canonical: two states have the same encoding iff
+  they have the same values. In particular, states cannot be encoded
+  relative to other states, e.g., as deltas to their parents.
+*/
+class StateCodec {
+public:
+    virtual ~StateCodec() = default;
+
+    virtual int get_num_bins() const = 0;
+    virtual void encode(const std::vector<int> &values, Bin *buffer) = 0;
+    virtual void decode(const Bin *buffer, std::vector<int> &values) const = 0;
+
+    // Bytes per state, including the memory used by the codec itself.
+    virtual double get_bytes_per_state(int num_states) const;
+    virtual void print_statistics(utils::LogProxy &log) const;
+};
+
+/*
+  Stores each variable in ceil(log2(domain size)) bits like IntPacker,
+  but lets variables straddle bin boundaries, so no bits are wasted at
+  the end of the bins.
+*/
+class TightPackingCodec : public StateCodec {
+    struct VariableInfo {
+        int bin;
+        int shift;
+        int num_bits;
+    };
+
+    std::vector<VariableInfo> var_infos;
+    int num_bins;
+public:
+    explicit TightPackingCodec(const TaskProxy &task_proxy);
+
+    virtual int get_num_bins() const override;
+    virtual void encode(const std::vector<int> &values, Bin *buffer) override;
+    virtual void decode(const Bin *buffer, std::vector<int> &values) const override;
+};
+
+/*
+  Collapse compression: the tightly packed data is split into chunks of
+  CHUNK_SIZE bins and each chunk is replaced by its index in a dictionary
+  of the distinct values seen at this chunk position. Remaining bins that
+  do not fill a chunk are stored verbatim. Since there are usually far
+  fewer distinct chunks than states, the dictionaries are small compared
+  to the state pool, and decoding a state only costs one dictionary access
+  per chunk.
+*/
+class DictionaryCodec : public StateCodec {
+    static const int CHUNK_SIZE = 2;
+
+    struct ChunkHash {
+        const segmented_vector::SegmentedArrayVector<Bin> &chunks;
+        explicit ChunkHash(
+            const segmented_vector::SegmentedArrayVector<Bin> &chunks)
+            : chunks(chunks) {
+        }
+
+        int_hash_set::HashType operator()(int id) const;
+    };
+
+    struct ChunkEqual {
+        const segmented_vector::SegmentedArrayVector<Bin> &chunks;
+        explicit ChunkEqual(
+            const segmented_vector::SegmentedArrayVector<Bin> &chunks)
+            : chunks(chunks) {
+        }
+
+        bool operator()(int lhs, int rhs) const;
+    };
+
+    struct Dictionary {
+        segmented_vector::SegmentedArrayVector<Bin> chunks;
+        int_hash_set::IntHashSet<ChunkHash, ChunkEqual> chunk_ids;
+
+        Dictionary();
+        int insert(const Bin *chunk);
+    };
+
+    TightPackingCodec packing_codec;
+    // One dictionary per chunk position.
+    std::vector<std::unique_ptr<Dictionary>> dictionaries;
+    int num_bins;
+    // Holds the tightly packed data during encoding and decoding.
+    mutable std::vector<Bin> packed_buffer;
+public:
+    explicit DictionaryCodec(const TaskProxy &task_proxy);
+
+    virtual int get_num_bins() const override;
+    virtual void encode(const std::vector<int> &values, Bin *buffer) override;
+    virtual void decode(const Bin *buffer, std::vector<int> &values) const override;
+
+    virtual double get_bytes_per_state(int num_states) const override;
+    virtual void print_statistics(utils::LogProxy &log) const override;
+};
+
+// Return the codec for the given compression, or nullptr for NONE.
+extern std::unique_ptr<StateCodec> create_state_codec(
+    StateCompression compression, const TaskProxy &task_proxy);
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef STATE_ID_H
 #define STATE_ID_H
 
+#include "utils/hash.h"
+
 #include <iostream>
 
 // For documentation on classes relevant to storing and working with registered
@@ -35,7 +37,17 @@ public:
     bool operator!=(const StateID &other) const {
         return !(*this == other);
     }
+
+    int hash() const {
+        return value;
+    }
 };
 
+namespace utils {
+inline void feed(HashState &hash_state, StateID id) {
+    feed(hash_state, id.hash());
+}
+}
+
 
 #endif
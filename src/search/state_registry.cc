@@ -9,13 +9,18 @@
 #include "task_utils/task_properties.h"
 #include "utils/logging.h"
 
+#include <algorithm>
+
 using namespace std;
 
-StateRegistry::StateRegistry(const TaskProxy &task_proxy)
+StateRegistry::StateRegistry(
+    const TaskProxy &task_proxy, StateCompression compression)
     : task_proxy(task_proxy),
       state_packer(task_properties::g_state_packers[task_proxy]),
       axiom_evaluator(g_axiom_evaluators[task_proxy]),
       num_variables(task_proxy.get_variables().size()),
+      codec(state_codec::create_state_codec(compression, task_proxy)),
+      encoded_buffer(get_bins_per_state()),
       state_data_pool(get_bins_per_state()),
       canonical_state_data_pool(get_bins_per_state()),
       registered_states(
@@ -25,18 +30,23 @@ StateRegistry::StateRegistry(const TaskProxy &task_proxy)
           StateIDSemanticHash(canonical_state_data_pool, get_bins_per_state()),
           StateIDSemanticEqual(canonical_state_data_pool, get_bins_per_state())),
       group(0),
-      has_symmetries_and_uses_dks(false) {
+      has_symmetries_and_uses_dks(false),
+      uses_single_pool(false),
+      num_symmetric_duplicates(0) {
 }
 
 void StateRegistry::set_group(const shared_ptr<Group> &group_) {
     // Group is only set from eager_search if it has symmetries and uses DKS.
+    assert(!codec);
     group = group_;
     has_symmetries_and_uses_dks = true;
+    uses_single_pool =
+        group->get_dks_state_storage() == DKSStateStorage::SINGLE_POOL;
 }
 
-StateID StateRegistry::insert_id_or_pop_state() {
+StateID StateRegistry::insert_id_or_pop_state(vector<int> *permutation_trace) {
     if (has_symmetries_and_uses_dks) {
-        return insert_id_or_pop_state_dks();
+        return insert_id_or_pop_state_dks(permutation_trace);
     }
     /*
       Attempt to insert a StateID for the last state of state_data_pool
@@ -54,7 +64,7 @@ StateID StateRegistry::insert_id_or_pop_state() {
     return StateID(result.first);
 }
 
-StateID StateRegistry::insert_id_or_pop_state_dks() {
+StateID StateRegistry::insert_id_or_pop_state_dks(vector<int> *permutation_trace) {
     /*
       Attempt to insert a StateID for the last state of state_data_pool
       if none is present yet. If this fails (another entry for this state
@@ -63,20 +73,19 @@ StateID StateRegistry::insert_id_or_pop_state_dks() {
     */
     StateID id(state_data_pool.size() - 1);
     // Adding an entry for the canonical state to the canonical_state_data_pool
-    vector<int> canonical_state =
-        group->get_canonical_representative(
-            task_proxy.create_state(*this, id, state_data_pool[state_data_pool.size() - 1]));
-    PackedStateBin *canonical_buffer = new PackedStateBin[state_packer.get_num_bins()];
-    fill_n(canonical_buffer, state_packer.get_num_bins(), 0);
-    for (int i = 0; i < num_variables; ++i) {
-        state_packer.set(canonical_buffer, i, canonical_state[i]);
-    }
-    canonical_state_data_pool.push_back(canonical_buffer);
-    delete[] canonical_buffer;
+    canonical_state_data_pool.push_back(state_data_pool[id.value]);
+    group->compute_canonical_representative(
+        canonical_state_data_pool[canonical_state_data_pool.size() - 1],
+        permutation_trace);
 
     pair<int, bool> result = canonical_registered_states.insert(id.value);
     bool is_new_entry = result.second;
     if (!is_new_entry) {
+        const PackedStateBin *registered_data = state_data_pool[result.first];
+        if (!equal(registered_data, registered_data + get_bins_per_state(),
+                   state_data_pool[id.value])) {
+            ++num_symmetric_duplicates;
+        }
         state_data_pool.pop_back();
         canonical_state_data_pool.pop_back();
     }
@@ -84,13 +93,81 @@ StateID StateRegistry::insert_id_or_pop_state_dks() {
     return StateID(result.first);
 }
 
+StateID StateRegistry::insert_canonical_id_or_pop_state(
+    const vector<int> &values, vector<int> *permutation_trace) {
+    /*
+      Overwrite the last state of state_data_pool with the canonical
+      representative of the given state and attempt to insert a StateID for
+      it. New entries remember the trace that leads from the given state to
+      its canonical representative, so that the given state can be recovered
+      in lookup_state.
+    */
+    vector<int> canonical_values = values;
+    vector<int> trace = group->compute_canonical_representative_and_trace(canonical_values);
+    if (permutation_trace) {
+        *permutation_trace = trace;
+    }
+    PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
+    for (int var = 0; var < num_variables; ++var) {
+        state_packer.set(buffer, var, canonical_values[var]);
+    }
+    StateID id(state_data_pool.size() - 1);
+    pair<int, bool> result = registered_states.insert(id.value);
+    bool is_new_entry = result.second;
+    if (is_new_entry) {
+        state_trace_ids.push_back(get_trace_id(move(trace)));
+    } else {
+        // The trace determines the state given its canonical representative.
+        if (traces[state_trace_ids[result.first]] != trace) {
+            ++num_symmetric_duplicates;
+        }
+        state_data_pool.pop_back();
+    }
+    assert(registered_states.size() == static_cast<int>(state_data_pool.size()));
+    assert(state_trace_ids.size() == state_data_pool.size());
+    return StateID(result.first);
+}
+
+StateID StateRegistry::encode_and_insert_state(const vector<int> &values) {
+    codec->encode(values, encoded_buffer.data());
+    state_data_pool.push_back(encoded_buffer.data());
+    return insert_id_or_pop_state();
+}
+
+int StateRegistry::get_trace_id(vector<int> &&trace) {
+    auto it = trace_ids.find(trace);
+    if (it != trace_ids.end()) {
+        return it->second;
+    }
+    int trace_id = traces.size();
+    trace_ids[trace] = trace_id;
+    traces.push_back(move(trace));
+    return trace_id;
+}
+
 State StateRegistry::lookup_state(StateID id) const {
     const PackedStateBin *buffer = state_data_pool[id.value];
+    if (uses_single_pool) {
+        vector<int> values(num_variables);
+        for (int var = 0; var < num_variables; ++var) {
+            values[var] = state_packer.get(buffer, var);
+        }
+        group->apply_inverse_trace(values, traces[state_trace_ids[id.value]]);
+        return task_proxy.create_state(*this, id, buffer, move(values));
+    } else if (codec) {
+        vector<int> values(num_variables);
+        codec->decode(buffer, values);
+        return task_proxy.create_state(*this, id, buffer, move(values));
+    }
     return task_proxy.create_state(*this, id, buffer);
 }
 
 const State &StateRegistry::get_initial_state() {
-    if (!cached_initial_state) {
+    if (!cached_initial_state && codec) {
+        State initial_state = task_proxy.get_initial_state();
+        StateID id = encode_and_insert_state(initial_state.get_unpacked_values());
+        cached_initial_state = utils::make_unique_ptr<State>(lookup_state(id));
+    } else if (!cached_initial_state) {
         int num_bins = get_bins_per_state();
         unique_ptr<PackedStateBin[]> buffer(new PackedStateBin[num_bins]);
         // Avoid garbage values in half-full bins.
@@ -101,7 +178,9 @@ const State &StateRegistry::get_initial_state() {
             state_packer.set(buffer.get(), i, initial_state[i].get_value());
         }
         state_data_pool.push_back(buffer.get());
-        StateID id = insert_id_or_pop_state();
+        StateID id = uses_single_pool ?
+            insert_canonical_id_or_pop_state(initial_state.get_unpacked_values()) :
+            insert_id_or_pop_state();
         cached_initial_state = utils::make_unique_ptr<State>(lookup_state(id));
     }
     return *cached_initial_state;
@@ -110,10 +189,9 @@ const State &StateRegistry::get_initial_state() {
 //TODO it would be nice to move the actual state creation (and operator application)
 //     out of the StateRegistry. This could for example be done by global functions
 //     operating on state buffers (PackedStateBin *).
-State StateRegistry::get_successor_state(const State &predecessor, const OperatorProxy &op) {
+vector<int> StateRegistry::apply_operator_to_buffer(
+    const State &predecessor, const OperatorProxy &op, PackedStateBin *buffer) {
     assert(!op.is_axiom());
-    state_data_pool.push_back(predecessor.get_buffer());
-    PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
     /* Experiments for issue348 showed that for tasks with axioms it's faster
        to compute successor states using unpacked data. */
     if (task_properties::has_axioms(task_proxy)) {
@@ -129,8 +207,7 @@ State StateRegistry::get_successor_state(const State &predecessor, const Operato
         for (size_t i = 0; i < new_values.size(); ++i) {
             state_packer.set(buffer, i, new_values[i]);
         }
-        StateID id = insert_id_or_pop_state();
-        return task_proxy.create_state(*this, id, buffer, move(new_values));
+        return new_values;
     } else {
         for (EffectProxy effect : op.get_effects()) {
             if (does_fire(effect, predecessor)) {
@@ -138,24 +215,90 @@ State StateRegistry::get_successor_state(const State &predecessor, const Operato
                 state_packer.set(buffer, effect_pair.var, effect_pair.value);
             }
         }
-        StateID id = insert_id_or_pop_state();
+        return vector<int>();
+    }
+}
+
+State StateRegistry::get_successor_state(
+    const State &predecessor, const OperatorProxy &op,
+    vector<int> *permutation_trace) {
+    if (uses_single_pool) {
+        predecessor.unpack();
+        State successor = predecessor.get_unregistered_successor(op);
+        state_data_pool.push_back(predecessor.get_buffer());
+        StateID id = insert_canonical_id_or_pop_state(
+            successor.get_unpacked_values(), permutation_trace);
+        return lookup_state(id);
+    } else if (codec) {
+        predecessor.unpack();
+        State successor = predecessor.get_unregistered_successor(op);
+        StateID id = encode_and_insert_state(successor.get_unpacked_values());
+        // Copying the values is cheaper than decoding the state again.
+        vector<int> values = successor.get_unpacked_values();
+        return task_proxy.create_state(
+            *this, id, state_data_pool[id.value], move(values));
+    }
+    state_data_pool.push_back(predecessor.get_buffer());
+    PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
+    if (predecessor.get_registry() != this && predecessor.get_registry()) {
+        /*
+          The packed data of other registries need not be the data of the
+          state itself (see uses_single_pool), so we use the unpacked values.
+        */
+        predecessor.unpack();
+        for (int var = 0; var < num_variables; ++var) {
+            state_packer.set(buffer, var, predecessor[var].get_value());
+        }
+    }
+    vector<int> new_values = apply_operator_to_buffer(predecessor, op, buffer);
+    StateID id = insert_id_or_pop_state(permutation_trace);
+    if (task_properties::has_axioms(task_proxy)) {
+        return task_proxy.create_state(*this, id, buffer, move(new_values));
+    } else {
         return task_proxy.create_state(*this, id, buffer);
     }
 }
 
-State StateRegistry::register_state_buffer(const vector<int> &state) {
-    PackedStateBin *buffer = new PackedStateBin[state_packer.get_num_bins()];
-    fill_n(buffer, state_packer.get_num_bins(), 0);
-    for (int i = 0; i < num_variables; ++i) {
-        state_packer.set(buffer, i, state[i]);
+State StateRegistry::get_canonical_successor_state(
+    const State &predecessor, const OperatorProxy &op, const Group &group,
+    vector<int> *permutation_trace) {
+    // Canonicalization and permutations work on uncompressed packed data.
+    assert(!codec);
+    /*
+      The last slot of the state data pool serves as scratch buffer: the
+      successor is computed and canonicalized there and the slot is popped
+      again if the canonical state is already registered.
+    */
+    state_data_pool.push_back(predecessor.get_buffer());
+    PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
+    apply_operator_to_buffer(predecessor, op, buffer);
+    bool changed;
+    if (group.uses_incremental_canonicalization()) {
+        changed = group.compute_canonical_successor_representative(
+            buffer, op, permutation_trace);
+    } else {
+        changed = group.compute_canonical_representative(
+            buffer, permutation_trace);
     }
-    state_data_pool.push_back(buffer);
-    delete[] buffer;
+    int num_states = registered_states.size();
+    StateID id = insert_id_or_pop_state();
+    if (changed && registered_states.size() == num_states) {
+        ++num_symmetric_duplicates;
+    }
+    return lookup_state(id);
+}
+
+State StateRegistry::register_canonical_state(const State &state, const Group &group) {
+    assert(!codec);
+    state_data_pool.push_back(state.get_buffer());
+    group.compute_canonical_representative(
+        state_data_pool[state_data_pool.size() - 1]);
     StateID id = insert_id_or_pop_state();
     return lookup_state(id);
 }
 
 State StateRegistry::permute_state(const State &state, const Permutation &permutation) {
+    assert(!codec);
     PackedStateBin *buffer = new PackedStateBin[state_packer.get_num_bins()];
     fill_n(buffer, state_packer.get_num_bins(), 0);
     for (int i = 0; i < num_variables; ++i) {
@@ -170,7 +313,17 @@ State StateRegistry::permute_state(const State &state, const Permutation &permut
     return lookup_state(id);
 }
 
+State StateRegistry::register_packed_state(const PackedStateBin *buffer) {
+    assert(!codec);
+    state_data_pool.push_back(buffer);
+    StateID id = insert_id_or_pop_state();
+    return lookup_state(id);
+}
+
 int StateRegistry::get_bins_per_state() const {
+    if (codec) {
+        return codec->get_num_bins();
+    }
     return state_packer.get_num_bins();
 }
 
@@ -181,4 +334,42 @@ int StateRegistry::get_state_size_in_bytes() const {
 void StateRegistry::print_statistics(utils::LogProxy &log) const {
     log << "Number of registered states: " << size() << endl;
     registered_states.print_statistics(log);
+    if (codec) {
+        log << "Bytes per state (uncompressed): "
+            << state_packer.get_num_bins() * sizeof(PackedStateBin) << endl;
+        log << "Bytes per state (compressed): "
+            << codec->get_bytes_per_state(size()) << endl;
+        codec->print_statistics(log);
+    }
+    if (has_symmetries_and_uses_dks) {
+        /*
+          Bytes of state data per state, i.e., excluding the hash sets. The
+          two-pool layout stores every state twice; the single-pool layout
+          stores it once, plus a trace id per state and the distinct traces.
+          Both are reported for the single-pool layout to compare them.
+        */
+        int state_size = get_state_size_in_bytes();
+        log << "Bytes per state (two pools): " << 2 * state_size << endl;
+        if (uses_single_pool) {
+            /*
+              Every distinct trace is stored twice, in traces and as key of
+              trace_ids. Each entry of trace_ids also needs a hash table
+              node with its id, a next pointer and the cached hash value.
+            */
+            size_t trace_bytes = 0;
+            for (const vector<int> &trace : traces) {
+                trace_bytes += 2 * (sizeof(vector<int>) + trace.size() * sizeof(int));
+            }
+            trace_bytes += trace_ids.size() *
+                (sizeof(int) + sizeof(void *) + sizeof(size_t));
+            trace_bytes += trace_ids.bucket_count() * sizeof(void *);
+            double single_pool_bytes = state_size + sizeof(int);
+            if (size() > 0) {
+                single_pool_bytes += static_cast<double>(trace_bytes) / size();
+            }
+            log << "Bytes per state (single pool): " << single_pool_bytes << endl;
+            log << "Number of distinct canonicalization traces: "
+                << traces.size() << endl;
+        }
+    }
 }
@@ -3,6 +3,7 @@
 
 #include "abstract_task.h"
 #include "axioms.h"
+#include "state_codec.h"
 #include "state_id.h"
 
 #include "algorithms/int_hash_set.h"
@@ -45,6 +46,9 @@
     such states in a single large array (see SegmentedArrayVector).
     PackedStateBin arrays are never manipulated directly but through
     the task's state packer (see IntPacker).
+    Registries can also store states in a compressed form (see StateCodec).
+    States of such registries are always unpacked on lookup, and their packed
+    data is only meaningful to the codec of their registry.
 
   -------------
 
@@ -58,6 +62,7 @@
     This class is used to store the actual (packed) state data for all states
     while avoiding dynamically allocating each state individually.
     The index within this vector corresponds to the ID of the state.
+    Its segments can be spilled to disk (see utils/spillable_memory.h).
 
   PerStateInformation<T>
     Associates a value of type T with every state in a given StateRegistry.
@@ -117,10 +122,10 @@ class Permutation;
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     struct StateIDSemanticHash {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        const segmented_vector::SpillableSegmentedArrayVector<PackedStateBin> &state_data_pool;
         int state_size;
         StateIDSemanticHash(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            const segmented_vector::SpillableSegmentedArrayVector<PackedStateBin> &state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool),
               state_size(state_size) {
@@ -137,10 +142,10 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     };
 
     struct StateIDSemanticEqual {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        const segmented_vector::SpillableSegmentedArrayVector<PackedStateBin> &state_data_pool;
         int state_size;
         StateIDSemanticEqual(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            const segmented_vector::SpillableSegmentedArrayVector<PackedStateBin> &state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool),
               state_size(state_size) {
@@ -164,10 +169,13 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     const int_packer::IntPacker &state_packer;
     AxiomEvaluator &axiom_evaluator;
     const int num_variables;
+    // Compresses the data in state_data_pool if not null.
+    std::unique_ptr<state_codec::StateCodec> codec;
+    std::vector<PackedStateBin> encoded_buffer;
 
-    segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+    segmented_vector::SpillableSegmentedArrayVector<PackedStateBin> state_data_pool;
     // Used for DKS
-    segmented_vector::SegmentedArrayVector<PackedStateBin> canonical_state_data_pool;
+    segmented_vector::SpillableSegmentedArrayVector<PackedStateBin> canonical_state_data_pool;
     StateIDSet registered_states;
     // Used for DKS
     StateIDSet canonical_registered_states;
@@ -175,15 +183,46 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     std::shared_ptr<Group> group;
     // true iff group has been set; added here to avoid including group.h in this header
     bool has_symmetries_and_uses_dks;
+    /*
+      Used for DKS with a single state pool: state_data_pool then stores the
+      canonical representatives and the states themselves are recovered on
+      lookup from the id of the trace of their canonicalization. Distinct
+      traces are stored only once.
+    */
+    bool uses_single_pool;
+    segmented_vector::SpillableSegmentedVector<int> state_trace_ids;
+    std::vector<std::vector<int>> traces;
+    utils::HashMap<std::vector<int>, int> trace_ids;
+    long long num_symmetric_duplicates;
 
     std::unique_ptr<State> cached_initial_state;
 
-    StateID insert_id_or_pop_state();
+    /*
+      If permutation_trace is given, the insertion functions that
+      canonicalize the state set it to the trace of the canonicalization.
+    */
+    StateID insert_id_or_pop_state(std::vector<int> *permutation_trace = nullptr);
     // Used for DKS
-    StateID insert_id_or_pop_state_dks();
+    StateID insert_id_or_pop_state_dks(std::vector<int> *permutation_trace);
+    // Used for DKS with a single state pool
+    StateID insert_canonical_id_or_pop_state(
+        const std::vector<int> &values,
+        std::vector<int> *permutation_trace = nullptr);
+    int get_trace_id(std::vector<int> &&trace);
+    // Used with a codec
+    StateID encode_and_insert_state(const std::vector<int> &values);
+    /*
+      Applies op to predecessor, writing the result into buffer, which must
+      contain the data of predecessor. For tasks with axioms, the unpacked
+      values of the successor are returned, otherwise the result is empty.
+    */
+    std::vector<int> apply_operator_to_buffer(
+        const State &predecessor, const OperatorProxy &op, PackedStateBin *buffer);
     int get_bins_per_state() const;
 public:
-    explicit StateRegistry(const TaskProxy &task_proxy);
+    explicit StateRegistry(
+        const TaskProxy &task_proxy,
+        StateCompression compression = StateCompression::NONE);
 
     // Used for DKS
     void set_group(const std::shared_ptr<Group> &group);
@@ -216,15 +255,32 @@ public:
       Returns the state that results from applying op to predecessor and
       registers it if this was not done before. This is an expensive operation
       as it includes duplicate checking.
+      With DKS, permutation_trace (if given) is set to the trace that maps
+      the successor to its canonical representative.
+    */
+    State get_successor_state(
+        const State &predecessor, const OperatorProxy &op,
+        std::vector<int> *permutation_trace = nullptr);
+
+    /*
+      Like get_successor_state, but registers and returns the canonical
+      representative of the successor. The successor is canonicalized in
+      place, so it is never registered itself. If permutation_trace is
+      given, it is set to the trace of the canonicalization.
+      Used for OSS.
     */
-    State get_successor_state(const State &predecessor, const OperatorProxy &op);
+    State get_canonical_successor_state(
+        const State &predecessor, const OperatorProxy &op, const Group &group,
+        std::vector<int> *permutation_trace = nullptr);
 
     /*
-      Registers and returns the state corresponding to the given state data.
-      This is an expensive operation as it includes duplicate checking.
+      Registers and returns the canonical representative of the given state
+      (which can be registered somewhere else). The packed state data is
+      copied and canonicalized in place. This is an expensive operation as it
+      includes duplicate checking.
       Used for OSS.
     */
-    State register_state_buffer(const std::vector<int> &state);
+    State register_canonical_state(const State &state, const Group &group);
 
     /*
       Creates the permutation of the given state (which can be registered
@@ -235,16 +291,33 @@ public:
     */
     State permute_state(const State &state, const Permutation &permutation);
 
+    /*
+      Registers and returns the state with the given packed data, which
+      must have been packed with the state packer of this task, e.g., in
+      another registry for the same task. This is an expensive operation
+      as it includes duplicate checking.
+    */
+    State register_packed_state(const PackedStateBin *buffer);
+
     /*
       Returns the number of states registered so far.
     */
     size_t size() const {
-        if (has_symmetries_and_uses_dks) {
+        if (has_symmetries_and_uses_dks && !uses_single_pool) {
             return canonical_registered_states.size();
         }
         return registered_states.size();
     }
 
+    /*
+      Returns the number of duplicates detected so far that differ from the
+      registered state, i.e., states that are only recognized as duplicates
+      because they are symmetric to a registered state (OSS and DKS).
+    */
+    long long get_num_symmetric_duplicates() const {
+        return num_symmetric_duplicates;
+    }
+
     int get_state_size_in_bytes() const;
 
     void print_statistics(utils::LogProxy &log) const;
@@ -0,0 +1,212 @@
+#include "automorphism_backend.h"
+
+#include "../utils/hash.h"
+#include "../utils/logging.h"
+#include "../utils/timer.h"
+
+#include "../bliss/graph.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <vector>
+
+using namespace std;
+
+static bliss::Digraph::SplittingHeuristic get_bliss_splitting_heuristic(
+    SplittingHeuristic splitting_heuristic) {
+    switch (splitting_heuristic) {
+    case SplittingHeuristic::F:
+        return bliss::Digraph::shs_f;
+    case SplittingHeuristic::FS:
+        return bliss::Digraph::shs_fs;
+    case SplittingHeuristic::FL:
+        return bliss::Digraph::shs_fl;
+    case SplittingHeuristic::FM:
+        return bliss::Digraph::shs_fm;
+    case SplittingHeuristic::FSM:
+        return bliss::Digraph::shs_fsm;
+    case SplittingHeuristic::FLM:
+        return bliss::Digraph::shs_flm;
+    }
+    return bliss::Digraph::shs_flm;
+}
+
+// Function that is called from bliss for every generator.
+static void report_generator(
+    void *user_param, unsigned int, const unsigned int *generator) {
+    (*static_cast<const AutomorphismBackend::GeneratorCallback *>(user_param))(
+        generator);
+}
+
+/*
+  Compute the coarsest stable coloring refining the vertex colors of the
+  graph: two vertices get the same color iff they have the same color in
+  the graph and, for every color, the same number of successors and the
+  same number of predecessors with that color.
+*/
+static vector<int> compute_stable_coloring(
+    const bliss::Digraph &graph,
+    const vector<vector<int>> &successors,
+    const vector<vector<int>> &predecessors) {
+    int num_vertices = graph.get_nof_vertices();
+    vector<int> colors(num_vertices);
+    map<unsigned int, int> color_by_graph_color;
+    for (int v = 0; v < num_vertices; ++v) {
+        colors[v] = color_by_graph_color.emplace(
+            graph.get_color(v), color_by_graph_color.size()).first->second;
+    }
+    int num_colors = color_by_graph_color.size();
+
+    vector<int> new_colors(num_vertices);
+    vector<int> signature;
+    while (true) {
+        utils::HashMap<vector<int>, int> color_by_signature;
+        for (int v = 0; v < num_vertices; ++v) {
+            signature.clear();
+            signature.push_back(colors[v]);
+            signature.push_back(successors[v].size());
+            for (int w : successors[v]) {
+                signature.push_back(colors[w]);
+            }
+            sort(signature.begin() + 2, signature.end());
+            size_t predecessors_start = signature.size();
+            for (int u : predecessors[v]) {
+                signature.push_back(colors[u]);
+            }
+            sort(signature.begin() + predecessors_start, signature.end());
+            new_colors[v] = color_by_signature.emplace(
+                signature, color_by_signature.size()).first->second;
+        }
+        colors.swap(new_colors);
+        // Colors are only split, so the coloring is stable iff no color was.
+        int new_num_colors = color_by_signature.size();
+        if (new_num_colors == num_colors) {
+            break;
+        }
+        num_colors = new_num_colors;
+    }
+    return colors;
+}
+
+AutomorphismBackend::AutomorphismBackend(
+    AutomorphismSearch search,
+    SplittingHeuristic splitting_heuristic,
+    bool refine_colors,
+    int time_bound)
+    : search(search),
+      splitting_heuristic(splitting_heuristic),
+      refine_colors(refine_colors),
+      time_bound(time_bound) {
+}
+
+void AutomorphismBackend::run_bliss(
+    bliss::Digraph &graph, const GeneratorCallback &add_generator) const {
+    graph.set_splitting_heuristic(
+        get_bliss_splitting_heuristic(splitting_heuristic));
+    graph.set_time_limit(time_bound);
+    bliss::Stats stats;
+    void *user_param = const_cast<GeneratorCallback *>(&add_generator);
+    if (search == AutomorphismSearch::CANONICAL_FORM) {
+        graph.canonical_form(stats, &report_generator, user_param);
+    } else {
+        graph.find_automorphisms(stats, &report_generator, user_param);
+    }
+    utils::g_log << "Bliss search tree nodes: " << stats.get_nof_nodes()
+                 << endl;
+}
+
+void AutomorphismBackend::run_bliss_on_refined_graph(
+    const bliss::Digraph &graph,
+    const GeneratorCallback &add_generator) const {
+    utils::Timer timer;
+    int num_vertices = graph.get_nof_vertices();
+    vector<vector<int>> successors(num_vertices);
+    vector<vector<int>> predecessors(num_vertices);
+    for (int v = 0; v < num_vertices; ++v) {
+        const vector<unsigned int> &edges = graph.get_edges_out(v);
+        successors[v].assign(edges.begin(), edges.end());
+        sort(successors[v].begin(), successors[v].end());
+        successors[v].erase(
+            unique(successors[v].begin(), successors[v].end()),
+            successors[v].end());
+        for (int w : successors[v]) {
+            predecessors[w].push_back(v);
+        }
+    }
+    vector<int> colors =
+        compute_stable_coloring(graph, successors, predecessors);
+
+    vector<int> color_class_sizes(num_vertices, 0);
+    for (int color : colors) {
+        ++color_class_sizes[color];
+    }
+    vector<int> reduced_vertex_by_vertex(num_vertices, -1);
+    vector<int> vertex_by_reduced_vertex;
+    for (int v = 0; v < num_vertices; ++v) {
+        if (color_class_sizes[colors[v]] > 1) {
+            reduced_vertex_by_vertex[v] = vertex_by_reduced_vertex.size();
+            vertex_by_reduced_vertex.push_back(v);
+        }
+    }
+    int num_reduced_vertices = vertex_by_reduced_vertex.size();
+    utils::g_log << "Color refinement: " << num_reduced_vertices << "/"
+                 << num_vertices << " vertices in non-singleton color "
+                 << "classes, time: " << timer << endl;
+    if (num_reduced_vertices == 0) {
+        // The graph only has the trivial automorphism.
+        return;
+    }
+
+    bliss::Digraph reduced_graph;
+    reduced_graph.reserve_vertices(num_reduced_vertices);
+    for (int v : vertex_by_reduced_vertex) {
+        reduced_graph.add_vertex(colors[v]);
+    }
+    for (int reduced_v = 0; reduced_v < num_reduced_vertices; ++reduced_v) {
+        for (int w : successors[vertex_by_reduced_vertex[reduced_v]]) {
+            int reduced_w = reduced_vertex_by_vertex[w];
+            if (reduced_w != -1) {
+                reduced_graph.add_edge(reduced_v, reduced_w);
+            }
+        }
+    }
+
+    // Removed vertices are fixed by all automorphisms.
+    vector<unsigned int> generator(num_vertices);
+    iota(generator.begin(), generator.end(), 0);
+    GeneratorCallback add_reduced_generator =
+        [&](const unsigned int *reduced_generator) {
+            for (int reduced_v = 0; reduced_v < num_reduced_vertices;
+                 ++reduced_v) {
+                generator[vertex_by_reduced_vertex[reduced_v]] =
+                    vertex_by_reduced_vertex[reduced_generator[reduced_v]];
+            }
+            add_generator(generator.data());
+        };
+    run_bliss(reduced_graph, add_reduced_generator);
+}
+
+void AutomorphismBackend::compute_generators(
+    bliss::Digraph &graph, const GeneratorCallback &add_generator) const {
+    utils::Timer timer;
+    utils::g_log << "Using Bliss to find group generators ("
+                 << (search == AutomorphismSearch::CANONICAL_FORM ?
+        "canonical form" : "generators only")
+                 << (refine_colors ? ", with color refinement" : "")
+                 << ")" << endl;
+    int num_generators = 0;
+    GeneratorCallback count_generator =
+        [&](const unsigned int *generator) {
+            ++num_generators;
+            add_generator(generator);
+        };
+    if (refine_colors) {
+        run_bliss_on_refined_graph(graph, count_generator);
+    } else {
+        run_bliss(graph, count_generator);
+    }
+    utils::g_log << "Automorphism search time: " << timer << endl;
+    utils::g_log << "Automorphism generators found: " << num_generators
+                 << endl;
+}
@@ -0,0 +1,74 @@
+#ifndef STRUCTURAL_SYMMETRIES_AUTOMORPHISM_BACKEND_H
+#define STRUCTURAL_SYMMETRIES_AUTOMORPHISM_BACKEND_H
+
+#include <functional>
+
+namespace bliss {
+class Digraph;
+}
+
+enum class AutomorphismSearch {
+    CANONICAL_FORM,
+    GENERATORS
+};
+
+// Splitting heuristics of bliss (see bliss::Digraph::SplittingHeuristic).
+enum class SplittingHeuristic {
+    F,
+    FS,
+    FL,
+    FM,
+    FSM,
+    FLM
+};
+
+/*
+  Computes generators of the automorphism group of a symmetry graph with
+  the bundled bliss.
+
+  With CANONICAL_FORM, bliss computes a canonical labeling of the graph
+  and reports the generators found on the way. With GENERATORS, it only
+  searches for automorphisms, which avoids exploring the search tree for
+  the best path labeling.
+
+  If refine_colors is set, we first compute the coarsest stable coloring
+  of the graph by color refinement. Every automorphism preserves this
+  coloring, so vertices in singleton color classes are fixed by all
+  automorphisms. Since vertices of the same stable color have the same
+  number of neighbors in every color class, we can remove these vertices
+  and search for automorphisms of the smaller graph colored with the
+  stable coloring. Its automorphisms, extended by fixing the removed
+  vertices, are exactly the automorphisms of the original graph.
+*/
+class AutomorphismBackend {
+public:
+    // Receives generators as permutations of all vertices of the graph.
+    using GeneratorCallback = std::function<void (const unsigned int *)>;
+private:
+    const AutomorphismSearch search;
+    const SplittingHeuristic splitting_heuristic;
+    const bool refine_colors;
+    const int time_bound;
+
+    void run_bliss(
+        bliss::Digraph &graph, const GeneratorCallback &add_generator) const;
+    void run_bliss_on_refined_graph(
+        const bliss::Digraph &graph,
+        const GeneratorCallback &add_generator) const;
+public:
+    AutomorphismBackend(
+        AutomorphismSearch search,
+        SplittingHeuristic splitting_heuristic,
+        bool refine_colors,
+        int time_bound);
+
+    /*
+      Report the generators of the automorphism group to add_generator.
+      Bliss signals timeouts and running out of memory with exceptions
+      derived from bliss::BlissException, which we pass on to the caller.
+    */
+    void compute_generators(
+        bliss::Digraph &graph, const GeneratorCallback &add_generator) const;
+};
+
+#endif
@@ -0,0 +1,321 @@
+#include "generator_cache.h"
+
+#include "group.h"
+#include "permutation.h"
+
+#include "../task_proxy.h"
+
+#include "../utils/hash.h"
+#include "../utils/logging.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static const char MAGIC[8] = {'F', 'D', 'S', 'Y', 'M', 'G', 'E', 'N'};
+static const int VERSION = 1;
+
+static void feed_fact(utils::HashState &hash_state, const FactProxy &fact) {
+    FactPair fact_pair = fact.get_pair();
+    hash_state.feed(fact_pair.var);
+    hash_state.feed(fact_pair.value);
+}
+
+static void feed_operator(utils::HashState &hash_state, const OperatorProxy &op) {
+    hash_state.feed(op.get_cost());
+    hash_state.feed(static_cast<int>(op.get_preconditions().size()));
+    for (FactProxy fact : op.get_preconditions()) {
+        feed_fact(hash_state, fact);
+    }
+    hash_state.feed(static_cast<int>(op.get_effects().size()));
+    for (EffectProxy effect : op.get_effects()) {
+        hash_state.feed(static_cast<int>(effect.get_conditions().size()));
+        for (FactProxy fact : effect.get_conditions()) {
+            feed_fact(hash_state, fact);
+        }
+        feed_fact(hash_state, effect.get_fact());
+    }
+}
+
+static uint64_t compute_fingerprint(
+    const TaskProxy &task_proxy,
+    bool stabilize_initial_state,
+    bool stabilize_goal,
+    bool use_color_for_stabilizing_goal) {
+    utils::HashState hash_state;
+    hash_state.feed(VERSION);
+    hash_state.feed(stabilize_initial_state);
+    hash_state.feed(stabilize_goal);
+    hash_state.feed(use_color_for_stabilizing_goal);
+    VariablesProxy variables = task_proxy.get_variables();
+    hash_state.feed(static_cast<int>(variables.size()));
+    for (VariableProxy var : variables) {
+        hash_state.feed(var.get_domain_size());
+        hash_state.feed(var.is_derived() ? var.get_axiom_layer() : -1);
+    }
+    State initial_state = task_proxy.get_initial_state();
+    for (size_t var = 0; var < initial_state.size(); ++var) {
+        hash_state.feed(initial_state[var].get_value());
+    }
+    GoalsProxy goals = task_proxy.get_goals();
+    hash_state.feed(static_cast<int>(goals.size()));
+    for (FactProxy fact : goals) {
+        feed_fact(hash_state, fact);
+    }
+    OperatorsProxy operators = task_proxy.get_operators();
+    hash_state.feed(static_cast<int>(operators.size()));
+    for (OperatorProxy op : operators) {
+        feed_operator(hash_state, op);
+    }
+    AxiomsProxy axioms = task_proxy.get_axioms();
+    hash_state.feed(static_cast<int>(axioms.size()));
+    for (OperatorProxy axiom : axioms) {
+        feed_operator(hash_state, axiom);
+    }
+    return hash_state.get_hash64();
+}
+
+/*
+  Check that the given raw generator is a permutation of the vertices
+  0, ..., permutation_length - 1 in the layout of
+  GraphCreator::create_bliss_directed_graph (variable vertices first, then
+  the value vertices of each variable) that maps each variable vertex to a
+  variable vertex and the value vertices of a variable to the value
+  vertices of its image.
+*/
+static bool is_valid_generator(
+    const vector<unsigned int> &generator, int num_vars,
+    const vector<int> &var_by_val) {
+    int permutation_length = generator.size();
+    vector<bool> is_image(permutation_length, false);
+    for (int vertex = 0; vertex < permutation_length; ++vertex) {
+        if (generator[vertex] >= static_cast<unsigned int>(permutation_length)) {
+            return false;
+        }
+        int image = generator[vertex];
+        if (is_image[image]) {
+            return false;
+        }
+        is_image[image] = true;
+        if (vertex < num_vars) {
+            if (image >= num_vars) {
+                return false;
+            }
+        } else {
+            if (image < num_vars) {
+                return false;
+            }
+            int var = var_by_val[vertex - num_vars];
+            int image_var = var_by_val[image - num_vars];
+            if (static_cast<int>(generator[var]) != image_var) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<typename T>
+static void write_value(ofstream &file, T value) {
+    file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool read_value(ifstream &file, T &value) {
+    file.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return static_cast<bool>(file);
+}
+
+GeneratorCache::GeneratorCache(
+    const string &directory,
+    const TaskProxy &task_proxy,
+    bool stabilize_initial_state,
+    bool stabilize_goal,
+    bool use_color_for_stabilizing_goal)
+    : fingerprint(compute_fingerprint(
+                      task_proxy, stabilize_initial_state, stabilize_goal,
+                      use_color_for_stabilizing_goal)),
+      directory(directory) {
+    ostringstream name;
+    name << directory << "/generators-" << hex << setw(16) << setfill('0')
+         << fingerprint << ".bin";
+    file_name = name.str();
+}
+
+bool GeneratorCache::load(const TaskProxy &task_proxy, Group &group) const {
+    ifstream file(file_name, ios::binary);
+    if (!file) {
+        utils::g_log << "No cached generators found in " << file_name << endl;
+        return false;
+    }
+    char magic[sizeof(MAGIC)];
+    int version;
+    uint64_t file_fingerprint;
+    int num_vars;
+    int permutation_length;
+    int graph_size;
+    int num_identity_generators;
+    int num_generators;
+    if (!file.read(magic, sizeof(MAGIC)) ||
+        !equal(magic, magic + sizeof(MAGIC), MAGIC) ||
+        !read_value(file, version) || version != VERSION ||
+        !read_value(file, file_fingerprint) || file_fingerprint != fingerprint ||
+        !read_value(file, num_vars) ||
+        num_vars != static_cast<int>(task_proxy.get_variables().size()) ||
+        !read_value(file, permutation_length) ||
+        !read_value(file, graph_size) ||
+        !read_value(file, num_identity_generators) ||
+        !read_value(file, num_generators)) {
+        utils::g_log << "Ignoring invalid generator cache " << file_name << endl;
+        return false;
+    }
+    /*
+      Check the header against the task and the file size before
+      allocating the generators, so that corrupt headers cannot make us
+      allocate huge amounts of memory.
+    */
+    // Same vertex layout as in GraphCreator::create_bliss_directed_graph.
+    vector<int> dom_sum_by_var;
+    vector<int> var_by_val;
+    int num_vertices_so_far = num_vars;
+    for (VariableProxy var : task_proxy.get_variables()) {
+        dom_sum_by_var.push_back(num_vertices_so_far);
+        num_vertices_so_far += var.get_domain_size();
+        for (int value = 0; value < var.get_domain_size(); ++value) {
+            var_by_val.push_back(var.get_id());
+        }
+    }
+    streampos generators_begin = file.tellg();
+    file.seekg(0, ios::end);
+    streamoff generators_bytes = file.tellg() - generators_begin;
+    file.seekg(generators_begin);
+    if (num_vertices_so_far != permutation_length || graph_size < 0 ||
+        num_identity_generators < 0 || num_generators < 0 || !file ||
+        generators_bytes != static_cast<streamoff>(num_generators) *
+        permutation_length * static_cast<streamoff>(sizeof(unsigned int))) {
+        utils::g_log << "Ignoring invalid generator cache " << file_name << endl;
+        return false;
+    }
+
+    vector<vector<unsigned int>> generators(
+        num_generators, vector<unsigned int>(permutation_length));
+    for (vector<unsigned int> &generator : generators) {
+        file.read(reinterpret_cast<char *>(generator.data()),
+                  permutation_length * sizeof(unsigned int));
+    }
+    if (!file) {
+        utils::g_log << "Ignoring truncated generator cache " << file_name << endl;
+        return false;
+    }
+    for (const vector<unsigned int> &generator : generators) {
+        if (!is_valid_generator(generator, num_vars, var_by_val)) {
+            utils::g_log << "Ignoring generator cache with invalid generators "
+                         << file_name << endl;
+            return false;
+        }
+    }
+
+    for (int dom_sum : dom_sum_by_var) {
+        group.add_to_dom_sum_by_var(dom_sum);
+    }
+    for (int var : var_by_val) {
+        group.add_to_var_by_val(var);
+    }
+    group.set_permutation_num_variables(num_vars);
+    group.set_permutation_length(permutation_length);
+    group.set_graph_size(graph_size);
+    group.set_num_identity_generators(num_identity_generators);
+    for (const vector<unsigned int> &generator : generators) {
+        group.add_raw_generator(generator.data());
+    }
+    utils::g_log << "Loaded " << num_generators << " cached generators from "
+                 << file_name << endl;
+    return true;
+}
+
+/*
+  Create an empty file with a unique name in the cache directory and
+  return its name, or the empty string on failure.
+*/
+string GeneratorCache::create_temporary_file() const {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    string path = directory + "/generators.tmp-XXXXXX";
+    vector<char> path_buffer(path.begin(), path.end());
+    path_buffer.push_back('\0');
+    int fd = mkstemp(path_buffer.data());
+    if (fd == -1) {
+        return string();
+    }
+    // mkstemp creates the file only readable by the owner.
+    fchmod(fd, 0644);
+    close(fd);
+    return string(path_buffer.data());
+#else
+    // Only one run per process writes to the cache.
+    return file_name + "." + to_string(utils::get_process_id()) + ".tmp";
+#endif
+}
+
+void GeneratorCache::save(const Group &group) const {
+    /*
+      Write to a temporary file with a unique name first and rename it
+      afterwards, so that concurrent runs neither write to the same file nor
+      read a partially written cache file.
+    */
+    string tmp_file_name = create_temporary_file();
+    if (tmp_file_name.empty()) {
+        utils::g_log << "Could not write generator cache " << file_name << endl;
+        return;
+    }
+    {
+        ofstream file(tmp_file_name, ios::binary);
+        if (!file) {
+            utils::g_log << "Could not write generator cache " << file_name << endl;
+            remove(tmp_file_name.c_str());
+            return;
+        }
+        int permutation_length = group.get_permutation_length();
+        file.write(MAGIC, sizeof(MAGIC));
+        write_value(file, VERSION);
+        write_value(file, fingerprint);
+        write_value(file, group.get_permutation_num_variables());
+        write_value(file, permutation_length);
+        write_value(file, group.get_graph_size());
+        write_value(file, group.get_num_identity_generators());
+        write_value(file, group.get_num_generators());
+        vector<unsigned int> generator(permutation_length);
+        for (int i = 0; i < group.get_num_generators(); ++i) {
+            const Permutation &permutation = group.get_permutation(i);
+            for (int j = 0; j < permutation_length; ++j) {
+                generator[j] = permutation.get_value(j);
+            }
+            file.write(reinterpret_cast<const char *>(generator.data()),
+                       permutation_length * sizeof(unsigned int));
+        }
+        if (!file) {
+            utils::g_log << "Could not write generator cache " << file_name << endl;
+            file.close();
+            remove(tmp_file_name.c_str());
+            return;
+        }
+    }
+    if (rename(tmp_file_name.c_str(), file_name.c_str()) != 0) {
+        utils::g_log << "Could not write generator cache " << file_name << endl;
+        remove(tmp_file_name.c_str());
+        return;
+    }
+    utils::g_log << "Wrote " << group.get_num_generators()
+                 << " generators to cache " << file_name << endl;
+}
@@ -0,0 +1,41 @@
+#ifndef STRUCTURAL_SYMMETRIES_GENERATOR_CACHE_H
+#define STRUCTURAL_SYMMETRIES_GENERATOR_CACHE_H
+
+#include <cstdint>
+#include <string>
+
+class Group;
+class TaskProxy;
+
+/*
+  Binary on-disk cache of the search generators of a task. The cache file is
+  named after a fingerprint of the task and of the options that influence the
+  symmetry graph, so a file is only reused for the same task and graph.
+  Loading a cached file replaces graph construction and bliss altogether.
+*/
+class GeneratorCache {
+    std::uint64_t fingerprint;
+    std::string directory;
+    std::string file_name;
+
+    std::string create_temporary_file() const;
+public:
+    GeneratorCache(
+        const std::string &directory,
+        const TaskProxy &task_proxy,
+        bool stabilize_initial_state,
+        bool stabilize_goal,
+        bool use_color_for_stabilizing_goal);
+
+    /*
+      Fill the group with the cached generators. Returns false (leaving the
+      group unchanged) if there is no valid cache file for the task. Besides
+      the header, this checks that the permutation length matches the task
+      and that each generator is a permutation that maps the vertices of a
+      variable and its values to those of another variable.
+    */
+    bool load(const TaskProxy &task_proxy, Group &group) const;
+    void save(const Group &group) const;
+};
+
+#endif
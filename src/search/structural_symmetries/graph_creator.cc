@@ -1,16 +1,19 @@
 #include "graph_creator.h"
 
+#include "automorphism_backend.h"
 #include "group.h"
 #include "permutation.h"
 
 #include "../task_proxy.h"
 
 #include "../utils/collections.h"
+#include "../utils/hash.h"
 #include "../utils/logging.h"
 #include "../utils/timer.h"
 
 #include "../bliss/graph.h"
 
+#include <algorithm>
 #include <fstream>
 #include <map>
 
@@ -35,17 +38,13 @@ static void out_of_memory_handler() {
     throw bliss::BlissMemoryOut();
 }
 
-// Function that is called from the graph automorphism tool.
-void add_permutation_to_group(void *group, unsigned int, const unsigned int *permutation) {
-    static_cast<Group *>(group)->add_raw_generator(permutation);
-}
-
 bool GraphCreator::compute_symmetries(
     const TaskProxy &task_proxy,
     const bool stabilize_initial_state,
     const bool stabilize_goal,
     const bool use_color_for_stabilizing_goal,
-    const int time_bound,
+    const bool compress_operators,
+    const AutomorphismBackend &automorphism_backend,
     const bool dump_symmetry_graph,
     Group *group) {
     bool success = false;
@@ -59,15 +58,16 @@ bool GraphCreator::compute_symmetries(
             stabilize_initial_state,
             stabilize_goal,
             use_color_for_stabilizing_goal,
+            compress_operators,
             dump_symmetry_graph,
             group,
             bliss_graph);
         group->set_graph_size(bliss_graph.get_nof_vertices());
-        bliss_graph.set_splitting_heuristic(bliss::Digraph::shs_flm);
-        bliss_graph.set_time_limit(time_bound);
-        bliss::Stats stats1;
-        utils::g_log << "Using Bliss to find group generators" << endl;
-        bliss_graph.canonical_form(stats1,&(add_permutation_to_group),group);
+        automorphism_backend.compute_generators(
+            bliss_graph,
+            [group](const unsigned int *generator) {
+                group->add_raw_generator(generator);
+            });
         utils::g_log << "Done initializing symmetries: " << timer << endl;
         group->statistics();
         success = true;
@@ -140,6 +140,7 @@ void GraphCreator::create_bliss_directed_graph(
     const bool stabilize_initial_state,
     const bool stabilize_goal,
     const bool use_color_for_stabilizing_goal,
+    const bool compress_operators,
     const bool dump_symmetry_graph,
     Group *group,
     bliss::Digraph &bliss_graph) const {
@@ -161,11 +162,68 @@ void GraphCreator::create_bliss_directed_graph(
     group->set_permutation_num_variables(vars.size());
     group->set_permutation_length(num_vertices_so_far);
 
+    /*
+      Collect the operators that get a vertex in the graph and the colors of
+      these vertices. Without compression, every operator gets a vertex
+      colored by its cost.
+    */
+    OperatorsProxy operators = task_proxy.get_operators();
+    vector<int> operator_vertex_ops;
+    vector<int> operator_vertex_colors;
+    int num_uncompressed_operator_vertices = 0;
+    if (compress_operators) {
+        num_uncompressed_operator_vertices = compute_operator_vertex_classes(
+            task_proxy, *group, operator_vertex_ops, operator_vertex_colors);
+    } else {
+        operator_vertex_ops.reserve(operators.size());
+        operator_vertex_colors.reserve(operators.size());
+        for (OperatorProxy op : operators) {
+            operator_vertex_ops.push_back(op.get_id());
+            operator_vertex_colors.push_back(OPERATOR_VERTEX + op.get_cost());
+        }
+    }
+
+    /*
+      Count the vertices and the edges of the value vertices up front, so
+      that bliss can reserve its adjacency lists instead of growing them.
+    */
+    int num_vertices = num_vertices_so_far;
+    vector<int> num_edges_out(num_vertices_so_far, 0);
+    vector<int> num_edges_in(num_vertices_so_far, 0);
+    int num_operator_vertices = 0;
+    for (int op_id : operator_vertex_ops) {
+        num_operator_vertices += count_operator_vertices_and_edges(
+            *group, operators[op_id], num_edges_out, num_edges_in);
+    }
+    num_vertices += num_operator_vertices;
+    for (OperatorProxy ax : task_proxy.get_axioms()) {
+        num_vertices += count_operator_vertices_and_edges(
+            *group, ax, num_edges_out, num_edges_in);
+    }
+    if (stabilize_initial_state) {
+        ++num_vertices;
+        for (FactProxy init_fact : task_proxy.get_initial_state()) {
+            ++num_edges_in[group->get_index_by_var_val_pair(
+                               init_fact.get_variable().get_id(),
+                               init_fact.get_value())];
+        }
+    }
+    if (stabilize_goal && !use_color_for_stabilizing_goal) {
+        ++num_vertices;
+        for (FactProxy goal_fact : task_proxy.get_goals()) {
+            ++num_edges_in[group->get_index_by_var_val_pair(
+                               goal_fact.get_variable().get_id(),
+                               goal_fact.get_value())];
+        }
+    }
+    bliss_graph.reserve_vertices(num_vertices);
+
     DotGraph dot_graph;
     int vertex = 0;
     // add vertex for each variable
     for (size_t i = 0; i < vars.size(); ++i) {
        vertex = bliss_graph.add_vertex(VARIABLE_VERTEX);
+       bliss_graph.reserve_edges(vertex, 0, vars[i].get_domain_size());
 
        if (dump_symmetry_graph) {
            dot_graph.add_node(vertex, "var" + to_string(i), dot_colors[VARIABLE_VERTEX]);
@@ -177,6 +235,8 @@ void GraphCreator::create_bliss_directed_graph(
         int var_id = var.get_id();
         for (int value = 0; value < var.get_domain_size(); value++){
             vertex = bliss_graph.add_vertex(VALUE_VERTEX);
+            bliss_graph.reserve_edges(
+                vertex, num_edges_out[vertex] + 1, num_edges_in[vertex]);
             bliss_graph.add_edge(vertex, var_id);
 
             if (dump_symmetry_graph) {
@@ -187,9 +247,9 @@ void GraphCreator::create_bliss_directed_graph(
     }
 
     // now add vertices for operators
-    for (OperatorProxy op : task_proxy.get_operators()) {
-        int color = OPERATOR_VERTEX + op.get_cost();
-        vertex = bliss_graph.add_vertex(color);
+    for (size_t i = 0; i < operator_vertex_ops.size(); ++i) {
+        OperatorProxy op = operators[operator_vertex_ops[i]];
+        vertex = bliss_graph.add_vertex(operator_vertex_colors[i]);
 
         if (dump_symmetry_graph) {
             dot_graph.add_node(
@@ -275,6 +335,166 @@ void GraphCreator::create_bliss_directed_graph(
     if (dump_symmetry_graph) {
         dot_graph.write();
     }
+
+    assert(static_cast<int>(bliss_graph.get_nof_vertices()) == num_vertices);
+    if (compress_operators) {
+        utils::g_log << "Symmetry graph operator vertices: "
+                     << operator_vertex_ops.size() << "/" << operators.size()
+                     << endl;
+        utils::g_log << "Symmetry graph size without operator compression: "
+                     << num_vertices - num_operator_vertices +
+            num_uncompressed_operator_vertices << endl;
+    }
+    utils::g_log << "Symmetry graph size: " << num_vertices << endl;
+}
+
+/*
+  Group the operators into classes of operators whose vertices would have
+  the same color and the same neighbors in the symmetry graph. Every class
+  gets a single vertex, represented by its first operator. To keep the
+  automorphisms of the graph, the vertex of a class is colored by the cost
+  and by the number of operators in the class, so that automorphisms only
+  map classes onto classes of the same size. Return the number of
+  operator vertices (including those for conditional effects) of the
+  uncompressed graph.
+*/
+int GraphCreator::compute_operator_vertex_classes(
+    const TaskProxy &task_proxy,
+    const Group &group,
+    vector<int> &operator_vertex_ops,
+    vector<int> &operator_vertex_colors) const {
+    utils::HashMap<vector<int>, int> class_by_key;
+    vector<int> class_sizes;
+    int num_uncompressed_operator_vertices = 0;
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        vector<int> key = compute_operator_vertex_key(group, op);
+        // The key stores the number of conditional effects at position 1.
+        num_uncompressed_operator_vertices += 1 + key[1];
+        auto result = class_by_key.emplace(
+            move(key), operator_vertex_ops.size());
+        if (result.second) {
+            operator_vertex_ops.push_back(op.get_id());
+            class_sizes.push_back(1);
+        } else {
+            ++class_sizes[result.first->second];
+        }
+    }
+
+    OperatorsProxy operators = task_proxy.get_operators();
+    map<pair<int, int>, int> color_by_cost_and_class_size;
+    for (size_t i = 0; i < operator_vertex_ops.size(); ++i) {
+        int cost = operators[operator_vertex_ops[i]].get_cost();
+        color_by_cost_and_class_size[make_pair(cost, class_sizes[i])] = 0;
+    }
+    int color = OPERATOR_VERTEX;
+    for (auto &entry : color_by_cost_and_class_size) {
+        entry.second = color++;
+    }
+    operator_vertex_colors.reserve(operator_vertex_ops.size());
+    for (size_t i = 0; i < operator_vertex_ops.size(); ++i) {
+        int cost = operators[operator_vertex_ops[i]].get_cost();
+        operator_vertex_colors.push_back(
+            color_by_cost_and_class_size[make_pair(cost, class_sizes[i])]);
+    }
+    return num_uncompressed_operator_vertices;
+}
+
+/*
+  Return a description of the vertex of the operator and its neighborhood
+  in the symmetry graph: the cost, the vertices of the preconditions and
+  unconditional effects and, for every conditional effect, its color and
+  the vertices of its effect and conditions.
+*/
+vector<int> GraphCreator::compute_operator_vertex_key(
+    const Group &group,
+    const OperatorProxy &op) const {
+    vector<int> precondition_vertices;
+    for (FactProxy prec_fact : op.get_preconditions()) {
+        FactPair fact = prec_fact.get_pair();
+        if (fact.value != -1) {
+            precondition_vertices.push_back(
+                group.get_index_by_var_val_pair(fact.var, fact.value));
+        }
+    }
+    sort(precondition_vertices.begin(), precondition_vertices.end());
+
+    vector<int> effect_vertices;
+    vector<vector<int>> conditional_effects;
+    EffectsProxy effects = op.get_effects();
+    for (size_t effect_id = 0; effect_id < effects.size(); ++effect_id) {
+        EffectProxy effect = effects[effect_id];
+        FactPair fact = effect.get_fact().get_pair();
+        int effect_vertex = group.get_index_by_var_val_pair(fact.var, fact.value);
+        EffectConditionsProxy conditions = effect.get_conditions();
+        if (conditions.empty()) {
+            effect_vertices.push_back(effect_vertex);
+        } else {
+            color_t effect_color = CONDITIONAL_EFFECT_VERTEX;
+            if (effect_can_be_overwritten(effect_id, effects)) {
+                effect_color = CONDITIONAL_DELETE_EFFECT_VERTEX;
+            }
+            vector<int> condition_vertices;
+            for (FactProxy condition : conditions) {
+                condition_vertices.push_back(group.get_index_by_var_val_pair(
+                    condition.get_variable().get_id(), condition.get_value()));
+            }
+            sort(condition_vertices.begin(), condition_vertices.end());
+            vector<int> conditional_effect = {effect_color, effect_vertex};
+            conditional_effect.insert(
+                conditional_effect.end(),
+                condition_vertices.begin(), condition_vertices.end());
+            conditional_effects.push_back(move(conditional_effect));
+        }
+    }
+    sort(effect_vertices.begin(), effect_vertices.end());
+    sort(conditional_effects.begin(), conditional_effects.end());
+
+    vector<int> key = {
+        op.get_cost(),
+        static_cast<int>(conditional_effects.size()),
+        static_cast<int>(precondition_vertices.size())};
+    key.insert(key.end(),
+               precondition_vertices.begin(), precondition_vertices.end());
+    key.push_back(effect_vertices.size());
+    key.insert(key.end(), effect_vertices.begin(), effect_vertices.end());
+    for (const vector<int> &conditional_effect : conditional_effects) {
+        key.push_back(conditional_effect.size());
+        key.insert(key.end(),
+                   conditional_effect.begin(), conditional_effect.end());
+    }
+    return key;
+}
+
+/*
+  Count the edges that add_operator_directed_graph adds to value vertices
+  for the given operator and return the number of vertices it adds.
+*/
+int GraphCreator::count_operator_vertices_and_edges(
+    const Group &group,
+    const OperatorProxy &op,
+    vector<int> &num_edges_out,
+    vector<int> &num_edges_in) const {
+    for (FactProxy prec_fact : op.get_preconditions()) {
+        FactPair fact = prec_fact.get_pair();
+        if (fact.value != -1) {
+            ++num_edges_out[group.get_index_by_var_val_pair(fact.var, fact.value)];
+        }
+    }
+    int num_vertices = 1;
+    for (EffectProxy effect : op.get_effects()) {
+        FactPair fact = effect.get_fact().get_pair();
+        ++num_edges_in[group.get_index_by_var_val_pair(fact.var, fact.value)];
+        EffectConditionsProxy conditions = effect.get_conditions();
+        if (!conditions.empty()) {
+            ++num_vertices;
+            for (FactProxy condition : conditions) {
+                ++num_edges_out[group.get_index_by_var_val_pair(
+                                    condition.get_variable().get_id(),
+                                    condition.get_value())];
+            }
+        }
+    }
+    return num_vertices;
 }
 
 void GraphCreator::add_operator_directed_graph(
@@ -6,6 +6,7 @@
 namespace bliss {
     class Digraph;
 }
+class AutomorphismBackend;
 struct DotGraph;
 class FactProxy;
 class EffectsProxy;
@@ -24,9 +25,23 @@ class GraphCreator  {
         const bool stabilize_initial_state,
         const bool stabilize_goal,
         const bool use_color_for_stabilizing_goal,
+        const bool compress_operators,
         const bool dump_symmetry_graph,
         Group *group,
         bliss::Digraph &bliss_graph) const;
+    int compute_operator_vertex_classes(
+        const TaskProxy &task_proxy,
+        const Group &group,
+        std::vector<int> &operator_vertex_ops,
+        std::vector<int> &operator_vertex_colors) const;
+    std::vector<int> compute_operator_vertex_key(
+        const Group &group,
+        const OperatorProxy &op) const;
+    int count_operator_vertices_and_edges(
+        const Group &group,
+        const OperatorProxy &op,
+        std::vector<int> &num_edges_out,
+        std::vector<int> &num_edges_in) const;
     void add_operator_directed_graph(
         const bool dump_symmetry_graph,
         Group *group,
@@ -46,7 +61,8 @@ public:
         const bool stabilize_initial_state,
         const bool stabilize_goal,
         const bool use_color_for_stabilizing_goal,
-        const int time_bound,
+        const bool compress_operators,
+        const AutomorphismBackend &automorphism_backend,
         const bool dump_symmetry_graph,
         Group *group);
 };
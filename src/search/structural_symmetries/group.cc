@@ -1,13 +1,17 @@
 #include "group.h"
 
+#include "generator_cache.h"
 #include "graph_creator.h"
 #include "permutation.h"
+#include "stabilizer_chain.h"
 
 #include "../option_parser.h"
 #include "../per_state_information.h"
 #include "../plugin.h"
 #include "../state_registry.h"
 #include "../task_proxy.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/logging.h"
 #include "../utils/memory.h"
 #include "../tasks/root_task.h"
 
@@ -16,6 +20,7 @@
 #include <iostream>
 #include <numeric>
 #include <queue>
+#include <set>
 
 
 using namespace std;
@@ -25,17 +30,39 @@ Group::Group(const options::Options &opts)
     : stabilize_initial_state(opts.get<bool>("stabilize_initial_state")),
       stabilize_goal(opts.get<bool>("stabilize_goal")),
       use_color_for_stabilizing_goal(opts.get<bool>("use_color_for_stabilizing_goal")),
+      compress_operator_vertices(opts.get<bool>("compress_operator_vertices")),
+      automorphism_search(opts.get<AutomorphismSearch>("automorphism_search")),
+      splitting_heuristic(opts.get<SplittingHeuristic>("splitting_heuristic")),
+      refine_colors(opts.get<bool>("refine_colors")),
       time_bound(opts.get<int>("time_bound")),
       dump_symmetry_graph(opts.get<bool>("dump_symmetry_graph")),
       search_symmetries(opts.get<SearchSymmetries>("search_symmetries")),
       dump_permutations(opts.get<bool>("dump_permutations")),
       write_search_generators(opts.get<bool>("write_search_generators")),
       write_all_generators(opts.get<bool>("write_all_generators")),
+      canonicalization(opts.get<Canonicalization>("canonicalization")),
+      dks_state_storage(opts.get<DKSStateStorage>("dks_state_storage")),
+      incremental_canonicalization(opts.get<bool>("incremental_canonicalization")),
+      record_traces(opts.get<bool>("record_traces")),
+      generator_cache_dir(opts.get<string>("generator_cache_dir", "")),
       num_vars(0),
       permutation_length(0),
       graph_size(0),
       num_identity_generators(0),
-      initialized(false) {
+      initialized(false),
+      state_packer(nullptr),
+      num_canonicalizations(0),
+      count_improved_canonicalizations(
+          canonicalization == Canonicalization::EXACT &&
+          utils::get_log_from_options(opts).is_at_least_verbose()),
+      num_improved_canonicalizations(0),
+      measure_time(utils::get_log_from_options(opts).is_at_least_verbose()),
+      canonicalization_timer(false),
+      path_tracing_timer(false),
+      composition_timer(false) {
+}
+
+Group::~Group() {
 }
 
 const Permutation &Group::get_permutation(int index) const {
@@ -55,18 +82,60 @@ void Group::compute_symmetries(const TaskProxy &task_proxy) {
         cerr << "Already computed symmetries" << endl;
         exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
     }
-    GraphCreator graph_creator;
-    bool success = graph_creator.compute_symmetries(
-        task_proxy,
-        stabilize_initial_state,
-        stabilize_goal,
-        use_color_for_stabilizing_goal,
-        time_bound,
-        dump_symmetry_graph,
-        this);
-    if (!success) {
-        generators.clear();
+    /*
+      Writing generators requires the full symmetry graph, so we do not use
+      the cache in this case.
+    */
+    unique_ptr<GeneratorCache> generator_cache;
+    if (!generator_cache_dir.empty() &&
+        !write_search_generators && !write_all_generators) {
+        generator_cache = utils::make_unique_ptr<GeneratorCache>(
+            generator_cache_dir,
+            task_proxy,
+            stabilize_initial_state,
+            stabilize_goal,
+            use_color_for_stabilizing_goal);
+    }
+    if (generator_cache && generator_cache->load(task_proxy, *this)) {
+        statistics();
+    } else {
+        GraphCreator graph_creator;
+        AutomorphismBackend automorphism_backend(
+            automorphism_search,
+            splitting_heuristic,
+            refine_colors,
+            time_bound);
+        bool success = graph_creator.compute_symmetries(
+            task_proxy,
+            stabilize_initial_state,
+            stabilize_goal,
+            use_color_for_stabilizing_goal,
+            compress_operator_vertices,
+            automorphism_backend,
+            dump_symmetry_graph,
+            this);
+        if (!success) {
+            generators.clear();
+        } else if (generator_cache) {
+            generator_cache->save(*this);
+        }
+    }
+    state_packer = &task_properties::g_state_packers[task_proxy];
+    for (Permutation &generator : generators) {
+        generator.compile_for_packed_states(*state_packer);
+    }
+    if (canonicalization == Canonicalization::EXACT && !generators.empty()) {
+        compute_stabilizer_chain();
+    }
+    if (uses_incremental_canonicalization()) {
+        compute_generators_by_affected_var(task_proxy);
     }
+    if (search_symmetries == SearchSymmetries::DKS &&
+        dks_state_storage == DKSStateStorage::SINGLE_POOL &&
+        !generators.empty()) {
+        prepare_inverse_traces();
+    }
+    num_improvements_by_generator.assign(generators.size(), 0);
     // Set initialized to true regardless of whether symmetries have been
     // found or not to avoid future attempts at computing symmetries if
     // none can be found.
@@ -78,6 +147,55 @@ void Group::compute_symmetries(const TaskProxy &task_proxy) {
     }
 }
 
+void Group::compute_stabilizer_chain() {
+    utils::Timer timer;
+    vector<RawPermutation> raw_generators;
+    raw_generators.reserve(generators.size());
+    for (const Permutation &generator : generators) {
+        RawPermutation raw_generator(permutation_length);
+        for (int i = 0; i < permutation_length; ++i) {
+            raw_generator[i] = generator.get_value(i);
+        }
+        raw_generators.push_back(move(raw_generator));
+    }
+    stabilizer_chain = utils::make_unique_ptr<StabilizerChain>(*this, raw_generators);
+    utils::g_log << "Stabilizer chain base length: "
+                 << stabilizer_chain->get_base_length() << endl;
+    utils::g_log << "Stabilizer chain strong generators: "
+                 << stabilizer_chain->get_num_strong_generators() << endl;
+    utils::g_log << "Stabilizer chain transversal elements: "
+                 << stabilizer_chain->get_num_transversal_elements() << endl;
+    utils::g_log << "Done computing stabilizer chain: " << timer << endl;
+}
+
+void Group::compute_generators_by_affected_var(const TaskProxy &task_proxy) {
+    generators_by_affected_var.assign(num_vars, vector<int>());
+    for (int i = 0; i < get_num_generators(); ++i) {
+        for (int var : generators[i].get_affected_vars()) {
+            generators_by_affected_var[var].push_back(i);
+        }
+    }
+    derived_vars.clear();
+    for (VariableProxy var : task_proxy.get_variables()) {
+        if (var.is_derived()) {
+            derived_vars.push_back(var.get_id());
+        }
+    }
+    is_generator_queued.assign(get_num_generators(), false);
+}
+
+void Group::prepare_inverse_traces() {
+    if (canonicalization == Canonicalization::EXACT) {
+        stabilizer_chain->compute_inverse_transversals();
+    } else {
+        inverse_generators.clear();
+        inverse_generators.reserve(generators.size());
+        for (const Permutation &generator : generators) {
+            inverse_generators.emplace_back(generator, true);
+        }
+    }
+}
+
 void Group::write_generators() const {
     assert(write_search_generators || write_all_generators);
 
@@ -234,62 +352,377 @@ void Group::statistics() const {
     }
 }
 
-vector<int> Group::get_canonical_representative(const State &state) const {
-    assert(has_symmetries());
-    state.unpack();
-    vector<int> canonical_state = state.get_unpacked_values();
+void Group::print_canonicalization_statistics() const {
+    if (!has_symmetries()) {
+        return;
+    }
+    utils::g_log << "Canonicalizations: " << num_canonicalizations << endl;
+    if (measure_time) {
+        utils::g_log << "Canonicalization time: " << canonicalization_timer
+                     << endl;
+    }
+    if (measure_time && num_canonicalizations > 0) {
+        utils::g_log << "Average canonicalization time: "
+                     << canonicalization_timer() / num_canonicalizations
+                     << "s" << endl;
+    }
+    if (count_improved_canonicalizations) {
+        utils::g_log << "Canonicalizations improving over greedy: "
+                     << num_improved_canonicalizations << endl;
+    }
+    if (!num_canonicalizations_by_passes.empty()) {
+        utils::g_log << "Greedy canonicalizations by fixpoint passes:";
+        for (size_t passes = 1; passes < num_canonicalizations_by_passes.size();
+             ++passes) {
+            utils::g_log << " " << passes << ":"
+                         << num_canonicalizations_by_passes[passes];
+        }
+        utils::g_log << endl;
+    }
+    utils::g_log << "Improvements by generator:";
+    for (long long num_improvements : num_improvements_by_generator) {
+        utils::g_log << " " << num_improvements;
+    }
+    utils::g_log << endl;
+    utils::g_log << "Path tracing time: " << path_tracing_timer << endl;
+    if (measure_time) {
+        utils::g_log << "Permutation composition time: " << composition_timer
+                     << endl;
+    }
+}
+
+static void write_time(ostream &out, bool measured, const utils::Timer &timer) {
+    // Times that were not measured (see Group::measure_time) are null.
+    if (measured) {
+        out << static_cast<double>(timer());
+    } else {
+        out << "null";
+    }
+}
 
+void Group::write_canonicalization_statistics(ostream &out) const {
+    out << "{\"canonicalizations\": " << num_canonicalizations
+        << ", \"improved_canonicalizations\": ";
+    // Like unmeasured times, uncounted improvements are null.
+    if (count_improved_canonicalizations) {
+        out << num_improved_canonicalizations;
+    } else {
+        out << "null";
+    }
+    out << ", \"canonicalization_time\": ";
+    write_time(out, measure_time, canonicalization_timer);
+    out << ", \"path_tracing_time\": ";
+    write_time(out, true, path_tracing_timer);
+    out << ", \"composition_time\": ";
+    write_time(out, measure_time, composition_timer);
+    out << ", \"canonicalizations_by_fixpoint_passes\": {";
+    string separator;
+    for (size_t passes = 1; passes < num_canonicalizations_by_passes.size();
+         ++passes) {
+        if (num_canonicalizations_by_passes[passes] > 0) {
+            out << separator << "\"" << passes << "\": "
+                << num_canonicalizations_by_passes[passes];
+            separator = ", ";
+        }
+    }
+    out << "}, \"improvements_by_generator\": [";
+    separator.clear();
+    for (long long num_improvements : num_improvements_by_generator) {
+        out << separator << num_improvements;
+        separator = ", ";
+    }
+    out << "]}";
+}
+
+void Group::record_fixpoint_passes(int num_passes) const {
+    if (num_passes >= static_cast<int>(num_canonicalizations_by_passes.size())) {
+        num_canonicalizations_by_passes.resize(num_passes + 1, 0);
+    }
+    ++num_canonicalizations_by_passes[num_passes];
+}
+
+bool Group::apply_greedy_canonicalization(
+    vector<int> &state, bool record_statistics) const {
+    bool changed_state = false;
     bool changed = true;
+    int num_passes = 0;
     while (changed) {
         changed = false;
+        ++num_passes;
         for (int i=0; i < get_num_generators(); i++) {
-            if (generators[i].replace_if_less(canonical_state)) {
+            if (generators[i].replace_if_less(state)) {
+                if (record_statistics) {
+                    ++num_improvements_by_generator[i];
+                }
                 changed =  true;
+                changed_state = true;
             }
         }
     }
-    return canonical_state;
+    if (record_statistics) {
+        record_fixpoint_passes(num_passes);
+    }
+    return changed_state;
 }
 
-vector<int> Group::compute_permutation_trace_to_canonical_representative(const State &state) const {
-    // TODO: duplicate code with get_canonical_representative
+void Group::canonicalize(vector<int> &state, vector<int> *permutation_trace) const {
+    ++num_canonicalizations;
+    if (canonicalization == Canonicalization::EXACT) {
+        vector<int> greedy_state;
+        if (count_improved_canonicalizations) {
+            // The greedy representative is only computed for the statistics.
+            greedy_state = state;
+            apply_greedy_canonicalization(greedy_state, false);
+        }
+        resume_timer(canonicalization_timer);
+        state = stabilizer_chain->compute_minimal_image(state, permutation_trace);
+        stop_timer(canonicalization_timer);
+        if (count_improved_canonicalizations && state != greedy_state) {
+            ++num_improved_canonicalizations;
+        }
+    } else {
+        resume_timer(canonicalization_timer);
+        apply_greedy_canonicalization(state);
+        stop_timer(canonicalization_timer);
+    }
+}
+
+vector<int> Group::get_canonical_representative(const State &state) const {
     assert(has_symmetries());
     state.unpack();
     vector<int> canonical_state = state.get_unpacked_values();
+    canonicalize(canonical_state);
+    return canonical_state;
+}
 
-    vector<int> permutation_trace;
+bool Group::compute_canonical_representative(
+    PackedStateBin *buffer, vector<int> *permutation_trace) const {
+    assert(has_symmetries());
+    if (canonicalization == Canonicalization::EXACT) {
+        vector<int> state(num_vars);
+        for (int var = 0; var < num_vars; ++var) {
+            state[var] = state_packer->get(buffer, var);
+        }
+        canonicalize(state, permutation_trace);
+        bool changed_state = false;
+        for (int var = 0; var < num_vars; ++var) {
+            if (state_packer->get(buffer, var) != state[var]) {
+                state_packer->set(buffer, var, state[var]);
+                changed_state = true;
+            }
+        }
+        return changed_state;
+    }
+
+    ++num_canonicalizations;
+    resume_timer(canonicalization_timer);
+    if (permutation_trace) {
+        permutation_trace->clear();
+    }
+    bool changed_state = false;
     bool changed = true;
+    int num_passes = 0;
     while (changed) {
         changed = false;
-        for (int i=0; i < get_num_generators(); i++) {
-            if (generators[i].replace_if_less(canonical_state)) {
-                permutation_trace.push_back(i);
+        ++num_passes;
+        for (int i = 0; i < get_num_generators(); ++i) {
+            if (generators[i].replace_if_less(buffer)) {
+                ++num_improvements_by_generator[i];
+                if (permutation_trace) {
+                    permutation_trace->push_back(i);
+                }
                 changed = true;
+                changed_state = true;
             }
         }
     }
+    record_fixpoint_passes(num_passes);
+    stop_timer(canonicalization_timer);
+    return changed_state;
+}
+
+void Group::queue_generators_affecting_var(int var) const {
+    for (int generator_index : generators_by_affected_var[var]) {
+        if (!is_generator_queued[generator_index]) {
+            is_generator_queued[generator_index] = true;
+            generator_queue.push_back(generator_index);
+        }
+    }
+}
+
+void Group::queue_generators_affecting_effects(const OperatorProxy &op) const {
+    assert(generator_queue.empty());
+    for (EffectProxy effect : op.get_effects()) {
+        queue_generators_affecting_var(effect.get_fact().get_variable().get_id());
+    }
+    for (int var : derived_vars) {
+        queue_generators_affecting_var(var);
+    }
+}
+
+int Group::pop_queued_generator() const {
+    int generator_index = generator_queue.front();
+    generator_queue.pop_front();
+    is_generator_queued[generator_index] = false;
+    return generator_index;
+}
+
+bool Group::compute_canonical_successor_representative(
+    PackedStateBin *buffer, const OperatorProxy &op,
+    vector<int> *permutation_trace) const {
+    assert(has_symmetries());
+    assert(uses_incremental_canonicalization());
+    /*
+      A generator can only map the successor to a smaller state if it
+      affects a variable on which the successor differs from its canonical
+      predecessor. Hence we only need to consider generators affecting the
+      effect variables and the derived variables (the axioms are evaluated
+      anew for the successor) and, after applying a generator, those
+      affecting the variables it changed.
+    */
+    ++num_canonicalizations;
+    resume_timer(canonicalization_timer);
+    if (permutation_trace) {
+        permutation_trace->clear();
+    }
+    bool changed_state = false;
+    queue_generators_affecting_effects(op);
+    while (!generator_queue.empty()) {
+        int generator_index = pop_queued_generator();
+        const Permutation &generator = generators[generator_index];
+        if (generator.replace_if_less(buffer)) {
+            ++num_improvements_by_generator[generator_index];
+            if (permutation_trace) {
+                permutation_trace->push_back(generator_index);
+            }
+            changed_state = true;
+            for (int var : generator.get_affected_vars()) {
+                queue_generators_affecting_var(var);
+            }
+        }
+    }
+    stop_timer(canonicalization_timer);
+    return changed_state;
+}
+
+vector<int> Group::compute_canonical_representative_and_trace(vector<int> &state) const {
+    assert(has_symmetries());
+    ++num_canonicalizations;
+    resume_timer(canonicalization_timer);
+    vector<int> permutation_trace;
+    if (canonicalization == Canonicalization::EXACT) {
+        state = stabilizer_chain->compute_minimal_image(state, &permutation_trace);
+    } else {
+        bool changed = true;
+        int num_passes = 0;
+        while (changed) {
+            changed = false;
+            ++num_passes;
+            for (int i=0; i < get_num_generators(); i++) {
+                if (generators[i].replace_if_less(state)) {
+                    ++num_improvements_by_generator[i];
+                    permutation_trace.push_back(i);
+                    changed = true;
+                }
+            }
+        }
+        record_fixpoint_passes(num_passes);
+    }
+    stop_timer(canonicalization_timer);
     return permutation_trace;
 }
 
+vector<int> Group::compute_permutation_trace_to_canonical_representative(const State &state) const {
+    state.unpack();
+    vector<int> canonical_state = state.get_unpacked_values();
+    return compute_canonical_representative_and_trace(canonical_state);
+}
+
 RawPermutation Group::compute_permutation_from_trace(const vector<int> &permutation_trace) const {
     assert(has_symmetries());
-    RawPermutation new_perm = new_identity_raw_permutation();
-    for (int permutation_index : permutation_trace) {
-        const Permutation &permutation = generators[permutation_index];
-        RawPermutation temp_perm(permutation_length);
-        for (int i = 0; i < permutation_length; i++) {
-           temp_perm[i] = permutation.get_value(new_perm[i]);
+    resume_timer(composition_timer);
+    RawPermutation new_perm;
+    if (canonicalization == Canonicalization::EXACT) {
+        new_perm = stabilizer_chain->compute_permutation_from_trace(permutation_trace);
+    } else {
+        new_perm = new_identity_raw_permutation();
+        for (int permutation_index : permutation_trace) {
+            const Permutation &permutation = generators[permutation_index];
+            RawPermutation temp_perm(permutation_length);
+            for (int i = 0; i < permutation_length; i++) {
+               temp_perm[i] = permutation.get_value(new_perm[i]);
+            }
+            new_perm.swap(temp_perm);
         }
-        new_perm.swap(temp_perm);
     }
+    stop_timer(composition_timer);
     return new_perm;
 }
 
+RawPermutation Group::compute_permutation_to_canonical_representative(
+    const State &state) const {
+    return compute_permutation_from_trace(
+        compute_permutation_trace_to_canonical_representative(state));
+}
+
+vector<int> Group::compute_permutation_trace_of_successor(
+    const State &successor, const OperatorProxy &op) const {
+    successor.unpack();
+    vector<int> canonical_state = successor.get_unpacked_values();
+    if (search_symmetries != SearchSymmetries::OSS ||
+        !uses_incremental_canonicalization()) {
+        return compute_canonical_representative_and_trace(canonical_state);
+    }
+    // Same as compute_canonical_successor_representative, recording the trace.
+    vector<int> permutation_trace;
+    queue_generators_affecting_effects(op);
+    while (!generator_queue.empty()) {
+        int generator_index = pop_queued_generator();
+        const Permutation &generator = generators[generator_index];
+        if (generator.replace_if_less(canonical_state)) {
+            ++num_improvements_by_generator[generator_index];
+            permutation_trace.push_back(generator_index);
+            for (int var : generator.get_affected_vars()) {
+                queue_generators_affecting_var(var);
+            }
+        }
+    }
+    return permutation_trace;
+}
+
+RawPermutation Group::create_permutation_from_canonical_successor(
+    const State &successor, const OperatorProxy &op) const {
+    assert(uses_incremental_canonicalization());
+    return compute_inverse_permutation(compute_permutation_from_trace(
+        compute_permutation_trace_of_successor(successor, op)));
+}
+
+void Group::apply_inverse_trace(vector<int> &state, const vector<int> &permutation_trace) const {
+    if (permutation_trace.empty()) {
+        return;
+    }
+    /*
+      The trace maps the state to its representative by applying its
+      elements from front to back, so we undo them from back to front.
+    */
+    if (canonicalization == Canonicalization::EXACT) {
+        stabilizer_chain->apply_inverse_trace(state, permutation_trace);
+    } else {
+        assert(inverse_generators.size() == generators.size());
+        for (auto it = permutation_trace.rbegin();
+             it != permutation_trace.rend(); ++it) {
+            inverse_generators[*it].permute(state);
+        }
+    }
+}
+
 RawPermutation Group::compute_inverse_permutation(const RawPermutation &permutation) const {
+    resume_timer(composition_timer);
     RawPermutation result(permutation_length);
     for (int i = 0; i < permutation_length; ++i) {
         result[permutation[i]] = i;
     }
+    stop_timer(composition_timer);
     return result;
 }
 
@@ -301,24 +734,51 @@ RawPermutation Group::new_identity_raw_permutation() const {
 
 RawPermutation Group::compose_permutations(
     const RawPermutation &permutation1, const RawPermutation & permutation2) const {
+    resume_timer(composition_timer);
     RawPermutation result(permutation_length);
     for (int i = 0; i < permutation_length; i++) {
        result[i] = permutation2[permutation1[i]];
     }
+    stop_timer(composition_timer);
     return result;
 }
 
 RawPermutation Group::create_permutation_from_state_to_state(
         const State& from_state, const State& to_state) const {
     assert(has_symmetries());
-    vector<int> from_state_permutation_trace = compute_permutation_trace_to_canonical_representative(from_state);
-    vector<int> to_state_permutation_trace = compute_permutation_trace_to_canonical_representative(to_state);
-
-    RawPermutation canonical_to_to_state_permutation = compute_inverse_permutation(compute_permutation_from_trace(to_state_permutation_trace));
-    RawPermutation from_state_to_canonical_permutation = compute_permutation_from_trace(from_state_permutation_trace);
+    RawPermutation canonical_to_to_state_permutation = compute_inverse_permutation(compute_permutation_to_canonical_representative(to_state));
+    RawPermutation from_state_to_canonical_permutation = compute_permutation_to_canonical_representative(from_state);
     return compose_permutations(from_state_to_canonical_permutation, canonical_to_to_state_permutation);
 }
 
+vector<RawPermutation> Group::compute_group_elements(int max_num_elements) const {
+    assert(has_symmetries());
+    RawPermutation identity = new_identity_raw_permutation();
+    set<RawPermutation> seen;
+    seen.insert(identity);
+    vector<RawPermutation> elements;
+    queue<RawPermutation> open;
+    open.push(move(identity));
+    while (!open.empty() && static_cast<int>(elements.size()) < max_num_elements) {
+        RawPermutation element = move(open.front());
+        open.pop();
+        for (const Permutation &generator : generators) {
+            RawPermutation successor(permutation_length);
+            for (int i = 0; i < permutation_length; ++i) {
+                successor[i] = generator.get_value(element[i]);
+            }
+            if (seen.insert(successor).second) {
+                elements.push_back(successor);
+                if (static_cast<int>(elements.size()) == max_num_elements) {
+                    break;
+                }
+                open.push(move(successor));
+            }
+        }
+    }
+    return elements;
+}
+
 int Group::get_var_by_index(int ind) const {
     // In case of ind < num_vars, returns the index itself, as this is the variable part of the permutation.
     if (ind < num_vars) {
@@ -356,10 +816,53 @@ static shared_ptr<Group> _parse(OptionParser &parser) {
                             "Use a color to stabilize the goal instead of "
                             "using an additional node linked to goal values.",
                             "true");
+    parser.add_option<bool>("compress_operator_vertices",
+                            "Use a single vertex in the symmetry graph for "
+                            "all operators with the same cost, preconditions "
+                            "and effects, colored by the number of operators "
+                            "it stands for. This yields the same search "
+                            "generators with a smaller graph, but no "
+                            "generators that only permute operators.",
+                            "false");
     parser.add_option<bool>("dump_symmetry_graph",
                            "Dump symmetry graph in dot format",
                            "false");
 
+    // Options for the automorphism search
+    vector<string> automorphism_search;
+    automorphism_search.push_back("CANONICAL_FORM");
+    automorphism_search.push_back("GENERATORS");
+    parser.add_enum_option<AutomorphismSearch>("automorphism_search",
+                           automorphism_search,
+                           "Choose how Bliss searches for automorphisms: "
+                           "CANONICAL_FORM computes a canonical labeling of "
+                           "the symmetry graph and reports the generators "
+                           "found on the way; GENERATORS only searches for "
+                           "generators of the automorphism group, which is "
+                           "usually cheaper",
+                           "CANONICAL_FORM");
+    vector<string> splitting_heuristic;
+    splitting_heuristic.push_back("F");
+    splitting_heuristic.push_back("FS");
+    splitting_heuristic.push_back("FL");
+    splitting_heuristic.push_back("FM");
+    splitting_heuristic.push_back("FSM");
+    splitting_heuristic.push_back("FLM");
+    parser.add_enum_option<SplittingHeuristic>("splitting_heuristic",
+                           splitting_heuristic,
+                           "Splitting heuristic of Bliss: the first (F), first "
+                           "smallest (FS) or first largest (FL) non-singleton "
+                           "cell, or the first (FM), first smallest (FSM) or "
+                           "first largest (FLM) maximally non-trivially "
+                           "connected non-singleton cell",
+                           "FLM");
+    parser.add_option<bool>("refine_colors",
+                           "Compute the coarsest stable coloring of the "
+                           "symmetry graph before the automorphism search and "
+                           "remove all vertices in singleton color classes, "
+                           "which are fixed by every automorphism",
+                           "false");
+
     // Type of search symmetries to be used
     vector<string> search_symmetries;
     search_symmetries.push_back("NONE");
@@ -373,6 +876,59 @@ static shared_ptr<Group> _parse(OptionParser &parser) {
                            "representative of every state during search",
                            "NONE");
 
+    vector<string> canonicalization;
+    canonicalization.push_back("GREEDY");
+    canonicalization.push_back("EXACT");
+    parser.add_enum_option<Canonicalization>("canonicalization",
+                           canonicalization,
+                           "Choose how canonical representatives are computed "
+                           "for OSS and DKS: GREEDY applies generators as long "
+                           "as they lead to a lexicographically smaller state; "
+                           "EXACT computes the lexicographically minimal state "
+                           "of the orbit using a stabilizer chain computed "
+                           "with the Schreier-Sims algorithm (with verbose "
+                           "verbosity, it also computes the greedy "
+                           "representative to count how often EXACT improves "
+                           "over it)",
+                           "GREEDY");
+
+    parser.add_option<bool>("incremental_canonicalization",
+                           "Canonicalize successor states in OSS incrementally, "
+                           "starting from the changed variables of the canonical "
+                           "parent state and only considering generators that "
+                           "affect changed variables (only for GREEDY "
+                           "canonicalization)",
+                           "false");
+
+    parser.add_option<string>("generator_cache_dir",
+                           "Directory of a cache of search generators. If set, "
+                           "the generators of the task are loaded from the "
+                           "cache instead of computing them, or written to it "
+                           "after computing them. Cache files are keyed by a "
+                           "fingerprint of the task and the options affecting "
+                           "the symmetry graph",
+                           OptionParser::NONE);
+    parser.add_option<bool>("record_traces",
+                           "Record for every search node the trace of the "
+                           "canonicalization of the state generated by its "
+                           "creating operator. Plans are then reconstructed in "
+                           "time linear in the plan length without generating "
+                           "successor states",
+                           "false");
+
+    vector<string> dks_state_storage;
+    dks_state_storage.push_back("TWO_POOLS");
+    dks_state_storage.push_back("SINGLE_POOL");
+    parser.add_enum_option<DKSStateStorage>("dks_state_storage",
+                           dks_state_storage,
+                           "Choose how the state registry stores states for DKS: "
+                           "TWO_POOLS stores every state together with its "
+                           "canonical representative; SINGLE_POOL only stores "
+                           "the canonical representative plus the id of the "
+                           "canonicalization trace, from which the state is "
+                           "recovered on lookup",
+                           "TWO_POOLS");
+
     parser.add_option<bool>("dump_permutations",
                            "Dump the generators",
                            "false");
@@ -386,6 +942,7 @@ static shared_ptr<Group> _parse(OptionParser &parser) {
         "Write all symmetry group generators to a file, including those that "
         "do not affect variables, and stop afterwards.",
         "false");
+    utils::add_log_options_to_parser(parser);
 
     Options opts = parser.parse();
 
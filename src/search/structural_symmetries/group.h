@@ -1,11 +1,21 @@
 #ifndef STRUCTURAL_SYMMETRIES_GROUP_H
 #define STRUCTURAL_SYMMETRIES_GROUP_H
 
+#include "automorphism_backend.h"
+
+#include "../algorithms/int_packer.h"
+#include "../utils/timer.h"
+
+#include <deque>
+#include <iosfwd>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
+class OperatorProxy;
 class Permutation;
+class StabilizerChain;
 class State;
 class StateRegistry;
 class TaskProxy;
@@ -20,20 +30,40 @@ enum class SearchSymmetries {
     DKS
 };
 
+enum class Canonicalization {
+    GREEDY,
+    EXACT
+};
+
+enum class DKSStateStorage {
+    TWO_POOLS,
+    SINGLE_POOL
+};
+
 // Permutation of bliss graph vertices.
 using RawPermutation = std::vector<int>;
+using PackedStateBin = int_packer::IntPacker::Bin;
 
 class Group {
     // Options for Bliss and the type of symmetries used
     const bool stabilize_initial_state;
     const bool stabilize_goal;
     const bool use_color_for_stabilizing_goal;
+    const bool compress_operator_vertices;
+    const AutomorphismSearch automorphism_search;
+    const SplittingHeuristic splitting_heuristic;
+    const bool refine_colors;
     const int time_bound;
     const bool dump_symmetry_graph;
     const SearchSymmetries search_symmetries;
     const bool dump_permutations;
     const bool write_search_generators;
     const bool write_all_generators;
+    const Canonicalization canonicalization;
+    const DKSStateStorage dks_state_storage;
+    const bool incremental_canonicalization;
+    const bool record_traces;
+    const std::string generator_cache_dir;
 
     // Group properties
     int num_vars;
@@ -47,18 +77,78 @@ class Group {
     bool initialized;
     std::vector<Permutation> generators;
     std::vector<std::unordered_map<int, int>> to_be_written_generators;
-    const Permutation &get_permutation(int index) const;
+    const int_packer::IntPacker *state_packer;
+    // Only used for exact canonicalization.
+    std::unique_ptr<StabilizerChain> stabilizer_chain;
+    // Only used for DKS with a single state pool and greedy canonicalization.
+    std::vector<Permutation> inverse_generators;
+    // Only used for incremental canonicalization.
+    std::vector<std::vector<int>> generators_by_affected_var;
+    // Derived variables can change with every operator application.
+    std::vector<int> derived_vars;
+    mutable std::deque<int> generator_queue;
+    mutable std::vector<bool> is_generator_queued;
+
+    // Canonicalization statistics
+    mutable int num_canonicalizations;
+    /*
+      Number of times the exact representative differs from the greedy one.
+      Computing the greedy representative for every exact canonicalization
+      is expensive, so we only count this with verbose verbosity level.
+    */
+    const bool count_improved_canonicalizations;
+    mutable int num_improved_canonicalizations;
+    /*
+      Measuring the time of every canonicalization induces a significant
+      overhead for cheap canonicalizations, so we only measure the times of
+      canonicalizations and permutation compositions with verbose
+      verbosity level (as in PruningMethod).
+    */
+    const bool measure_time;
+    mutable utils::Timer canonicalization_timer;
+    /*
+      Number of greedy canonicalizations by the number of passes over all
+      generators until a fixpoint is reached (including the last pass that
+      changes nothing). Incremental canonicalizations are not included.
+    */
+    mutable std::vector<int> num_canonicalizations_by_passes;
+    // Number of times each generator mapped a state to a smaller state.
+    mutable std::vector<long long> num_improvements_by_generator;
+    mutable utils::Timer path_tracing_timer;
+    // Time for computing, inverting and composing permutations.
+    mutable utils::Timer composition_timer;
+
+    void resume_timer(utils::Timer &timer) const {
+        if (measure_time) {
+            timer.resume();
+        }
+    }
+    void stop_timer(utils::Timer &timer) const {
+        if (measure_time) {
+            timer.stop();
+        }
+    }
+
+    void compute_stabilizer_chain();
+    void compute_generators_by_affected_var(const TaskProxy &task_proxy);
+    void prepare_inverse_traces();
+    void queue_generators_affecting_var(int var) const;
+    void queue_generators_affecting_effects(const OperatorProxy &op) const;
+    int pop_queued_generator() const;
+    void record_fixpoint_passes(int num_passes) const;
+    bool apply_greedy_canonicalization(
+        std::vector<int> &state, bool record_statistics = true) const;
+    void canonicalize(
+        std::vector<int> &state, std::vector<int> *permutation_trace = nullptr) const;
 
     // Path tracing
-    std::vector<int> compute_permutation_trace_to_canonical_representative(const State& state) const;
-    RawPermutation compute_permutation_from_trace(const std::vector<int> &permutation_trace) const;
-    RawPermutation compute_inverse_permutation(const RawPermutation &permutation) const;
+    RawPermutation compute_permutation_to_canonical_representative(const State &state) const;
 
     void write_generators() const;
     void add_to_be_written_generator(const unsigned int *generator);
 public:
     explicit Group(const options::Options &opts);
-    ~Group() = default;
+    ~Group();
 
     // Graph creator
     void add_to_dom_sum_by_var(int summed_dom);
@@ -82,12 +172,20 @@ public:
     void set_graph_size(int length) {
         graph_size = length;
     }
+    int get_graph_size() const {
+        return graph_size;
+    }
+    // Used when loading cached generators
+    void set_num_identity_generators(int num) {
+        num_identity_generators = num;
+    }
     int get_var_by_index(int val) const;
     std::pair<int, int> get_var_val_by_index(const int ind) const;
     int get_index_by_var_val_pair(const int var, const int val) const;
 
     // Using the group
     int get_num_generators() const;
+    const Permutation &get_permutation(int index) const;
     int get_num_identity_generators() const {
         return num_identity_generators;
     }
@@ -95,9 +193,22 @@ public:
     void dump_variables_equivalence_classes() const;
     void write_generators_to_file() const;
     void statistics() const;
+    void print_canonicalization_statistics() const;
+    // Write the canonicalization statistics as a JSON object.
+    void write_canonicalization_statistics(std::ostream &out) const;
+    // Path tracing is timed by the search space.
+    void start_path_tracing_timer() const {
+        path_tracing_timer.resume();
+    }
+    void stop_path_tracing_timer() const {
+        path_tracing_timer.stop();
+    }
     bool is_stabilizing_initial_state() const {
         return stabilize_initial_state;
     }
+    bool is_stabilizing_goal() const {
+        return stabilize_goal;
+    }
     bool is_initialized() const {
         return initialized;
     }
@@ -107,15 +218,95 @@ public:
     SearchSymmetries get_search_symmetries() const {
         return search_symmetries;
     }
+    Canonicalization get_canonicalization() const {
+        return canonicalization;
+    }
+    DKSStateStorage get_dks_state_storage() const {
+        return dks_state_storage;
+    }
+    bool records_traces() const {
+        return record_traces;
+    }
+    bool uses_incremental_canonicalization() const {
+        return incremental_canonicalization &&
+               canonicalization == Canonicalization::GREEDY;
+    }
 
     // Used for OSS
     std::vector<int> get_canonical_representative(const State &state) const;
+    /*
+      Replace the packed state in the given buffer by its canonical
+      representative. This avoids unpacking and repacking the state and is
+      used for OSS and DKS during search. Return true iff the state changed.
+      If permutation_trace is given, it is set to the trace of the
+      canonicalization (see compute_canonical_representative_and_trace).
+    */
+    bool compute_canonical_representative(
+        PackedStateBin *buffer, std::vector<int> *permutation_trace = nullptr) const;
+    /*
+      Replace the given state by its canonical representative and return the
+      trace of the canonicalization, which can be used to map the canonical
+      representative back to the state (see apply_inverse_trace). Traces are
+      short sequences of generator ids (GREEDY) or of stabilizer chain
+      transversal element ids (EXACT).
+      Used for DKS with a single state pool.
+    */
+    std::vector<int> compute_canonical_representative_and_trace(
+        std::vector<int> &state) const;
+    /*
+      Incremental variant of compute_canonical_representative for states that
+      result from applying op to a state that is canonical, i.e., that no
+      generator maps to a smaller state. Only generators affecting a variable
+      of an effect of op or a variable changed by an applied generator are
+      considered. The result is canonical in the same sense, but it may be a
+      different one than the non-incremental variant finds. Return true iff
+      the state changed. If permutation_trace is given, it is set to the
+      trace of the canonicalization.
+      Used for OSS.
+    */
+    bool compute_canonical_successor_representative(
+        PackedStateBin *buffer, const OperatorProxy &op,
+        std::vector<int> *permutation_trace = nullptr) const;
+    /*
+      Replace the given canonical representative by the state whose
+      canonicalization produced the given trace. Used for DKS with a single
+      state pool.
+    */
+    void apply_inverse_trace(
+        std::vector<int> &state, const std::vector<int> &permutation_trace) const;
     // Following methods: used for path tracing (OSS and DKS)
+    std::vector<int> compute_permutation_trace_to_canonical_representative(const State& state) const;
+    /*
+      Return the trace that maps the given successor (generated with op) to
+      the canonical representative that the state registry uses for it.
+      This canonicalizes the successor again, so it is only meant for plan
+      reconstruction; during search, the state registry returns the trace
+      of its own canonicalization.
+    */
+    std::vector<int> compute_permutation_trace_of_successor(
+        const State &successor, const OperatorProxy &op) const;
+    RawPermutation compute_permutation_from_trace(const std::vector<int> &permutation_trace) const;
+    RawPermutation compute_inverse_permutation(const RawPermutation &permutation) const;
     RawPermutation new_identity_raw_permutation() const;
     RawPermutation compose_permutations(
         const RawPermutation &permutation1, const RawPermutation &permutation2) const;
     RawPermutation create_permutation_from_state_to_state(
         const State &from_state, const State &to_state) const;
+    /*
+      Return the permutation that maps the canonical representative computed
+      by compute_canonical_successor_representative for the given successor
+      (generated with op) to the successor.
+    */
+    RawPermutation create_permutation_from_canonical_successor(
+        const State &successor, const OperatorProxy &op) const;
+
+    /*
+      Used for symmetric heuristic lookups: enumerate non-identity group
+      elements breadth-first from the generators (the generators come first)
+      until max_num_elements elements have been found or the group has been
+      exhausted.
+    */
+    std::vector<RawPermutation> compute_group_elements(int max_num_elements) const;
 };
 
 #endif
@@ -0,0 +1,86 @@
+#include "operator_mapper.h"
+
+#include "permutation.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+/*
+  Return a description of the operator with all facts mapped by the given
+  permutation (or unmapped if permutation is nullptr) such that an operator
+  is the image of another operator iff its signature equals the mapped
+  signature of the other operator.
+*/
+static vector<int> compute_operator_signature(
+    OperatorProxy op, const Permutation *permutation) {
+    auto map_fact = [permutation](const FactPair &fact) {
+        if (!permutation)
+            return fact;
+        pair<int, int> var_val =
+            permutation->get_new_var_val_by_old_var_val(fact.var, fact.value);
+        return FactPair(var_val.first, var_val.second);
+    };
+
+    vector<FactPair> preconditions;
+    for (FactProxy precondition : op.get_preconditions())
+        preconditions.push_back(map_fact(precondition.get_pair()));
+    sort(preconditions.begin(), preconditions.end());
+
+    vector<vector<int>> effects;
+    for (EffectProxy effect : op.get_effects()) {
+        vector<FactPair> conditions;
+        for (FactProxy condition : effect.get_conditions())
+            conditions.push_back(map_fact(condition.get_pair()));
+        sort(conditions.begin(), conditions.end());
+        FactPair fact = map_fact(effect.get_fact().get_pair());
+        vector<int> effect_signature = {fact.var, fact.value};
+        for (const FactPair &condition : conditions) {
+            effect_signature.push_back(condition.var);
+            effect_signature.push_back(condition.value);
+        }
+        effects.push_back(move(effect_signature));
+    }
+    sort(effects.begin(), effects.end());
+
+    vector<int> signature = {
+        op.get_cost(), static_cast<int>(preconditions.size())};
+    for (const FactPair &precondition : preconditions) {
+        signature.push_back(precondition.var);
+        signature.push_back(precondition.value);
+    }
+    for (const vector<int> &effect_signature : effects) {
+        signature.push_back(effect_signature.size());
+        signature.insert(
+            signature.end(), effect_signature.begin(), effect_signature.end());
+    }
+    return signature;
+}
+
+OperatorMapper::OperatorMapper(const TaskProxy &task_proxy)
+    : task_proxy(task_proxy) {
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        ops_by_signature[compute_operator_signature(op, nullptr)].push_back(
+            op.get_id());
+    }
+}
+
+vector<int> OperatorMapper::compute_operator_mapping(
+    const Permutation &permutation) const {
+    vector<int> mapping;
+    mapping.reserve(task_proxy.get_operators().size());
+    utils::HashMap<vector<int>, int> num_mapped_ops_by_signature;
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        vector<int> image_signature =
+            compute_operator_signature(op, &permutation);
+        auto it = ops_by_signature.find(image_signature);
+        if (it == ops_by_signature.end()) {
+            return {};
+        }
+        int &num_mapped_ops = num_mapped_ops_by_signature[image_signature];
+        assert(num_mapped_ops < static_cast<int>(it->second.size()));
+        mapping.push_back(it->second[num_mapped_ops++]);
+    }
+    return mapping;
+}
@@ -0,0 +1,36 @@
+#ifndef STRUCTURAL_SYMMETRIES_OPERATOR_MAPPER_H
+#define STRUCTURAL_SYMMETRIES_OPERATOR_MAPPER_H
+
+#include "../task_proxy.h"
+
+#include "../utils/hash.h"
+
+#include <vector>
+
+class Permutation;
+
+/*
+  Permutations only map the facts of a task. This class computes the
+  mapping of the operators induced by a permutation: an operator is mapped
+  onto an operator with the same cost whose preconditions, effects and
+  effect conditions are the images of those of the operator. Operators
+  with identical signatures are interchangeable, so the i-th operator with
+  a given image signature is mapped onto the i-th operator with this
+  signature.
+*/
+class OperatorMapper {
+    TaskProxy task_proxy;
+    utils::HashMap<std::vector<int>, std::vector<int>> ops_by_signature;
+public:
+    explicit OperatorMapper(const TaskProxy &task_proxy);
+
+    /*
+      Return the operator mapping induced by the permutation, or an empty
+      vector if the permutation does not map the operators of the task
+      onto each other (e.g., because the task has transformed costs).
+    */
+    std::vector<int> compute_operator_mapping(
+        const Permutation &permutation) const;
+};
+
+#endif
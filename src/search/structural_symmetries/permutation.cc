@@ -248,6 +248,11 @@ bool Permutation::replace_if_less(vector<int> &state) const {
     if (from_here == static_cast<int>(vars_affected.size()))
         return false;
 
+    permute(state);
+    return true;
+}
+
+void Permutation::permute(vector<int> &state) const {
     for(size_t i = 0; i < affected_vars_cycles.size(); i++) {
         if (affected_vars_cycles[i].size() == 1) {
             int var = affected_vars_cycles[i][0];
@@ -271,6 +276,101 @@ bool Permutation::replace_if_less(vector<int> &state) const {
         pair<int, int> to_pair = get_new_var_val_by_old_var_val(last_var, last_val);
         state[affected_vars_cycles[i][0]] = to_pair.second;
     }
+}
+
+void Permutation::compile_for_packed_states(const int_packer::IntPacker &state_packer) {
+    compiled_vars.clear();
+    compiled_cycles.clear();
+    compiled_cycle_ends.clear();
+    compiled_new_values.clear();
+
+    vector<int> compiled_index_by_var(group.get_permutation_num_variables(), -1);
+    for (int to_var : vars_affected) {
+        int from_var = from_vars[to_var];
+        assert(from_var != -1);
+        CompiledVariable compiled_var;
+        compiled_var.to_var = {state_packer.get_bin_index(to_var),
+                               state_packer.get_shift(to_var),
+                               state_packer.get_read_mask(to_var)};
+        compiled_var.from_var = {state_packer.get_bin_index(from_var),
+                                 state_packer.get_shift(from_var),
+                                 state_packer.get_read_mask(from_var)};
+        compiled_var.new_values_offset = compiled_new_values.size();
+        for (int ind = group.get_index_by_var_val_pair(from_var, 0);
+             ind < group.get_permutation_length() &&
+             group.get_var_by_index(ind) == from_var; ++ind) {
+            pair<int, int> var_val = group.get_var_val_by_index(get_value(ind));
+            assert(var_val.first == to_var);
+            compiled_new_values.push_back(var_val.second);
+        }
+        compiled_index_by_var[to_var] = compiled_vars.size();
+        compiled_vars.push_back(compiled_var);
+    }
+
+    for (const vector<int> &cycle : affected_vars_cycles) {
+        for (int var : cycle) {
+            assert(compiled_index_by_var[var] != -1);
+            compiled_cycles.push_back(compiled_index_by_var[var]);
+        }
+        compiled_cycle_ends.push_back(compiled_cycles.size());
+    }
+}
+
+static inline int read_packed_value(
+    const PackedStateBin *buffer, int bin_index, int shift, PackedStateBin read_mask) {
+    return (buffer[bin_index] & read_mask) >> shift;
+}
+
+static inline void write_packed_value(
+    PackedStateBin *buffer, int bin_index, int shift, PackedStateBin read_mask, int value) {
+    PackedStateBin &bin = buffer[bin_index];
+    bin = (bin & ~read_mask) | (value << shift);
+}
+
+// Same as replace_if_less on unpacked states, using the compiled tables.
+bool Permutation::replace_if_less(PackedStateBin *buffer) const {
+    if (identity())
+        return false;
+    assert(compiled_vars.size() == vars_affected.size());
+
+    bool is_less = false;
+    for (int i = static_cast<int>(compiled_vars.size()) - 1; i >= 0; --i) {
+        const CompiledVariable &var = compiled_vars[i];
+        int from_val = read_packed_value(
+            buffer, var.from_var.bin_index, var.from_var.shift, var.from_var.read_mask);
+        int to_val = compiled_new_values[var.new_values_offset + from_val];
+        int old_val = read_packed_value(
+            buffer, var.to_var.bin_index, var.to_var.shift, var.to_var.read_mask);
+        if (to_val == old_val)
+            continue;
+        is_less = to_val < old_val;
+        break;
+    }
+    if (!is_less)
+        return false;
 
+    int cycle_start = 0;
+    for (int cycle_end : compiled_cycle_ends) {
+        /*
+          The last variable of the cycle is overwritten first, so we remember
+          its value, which is mapped onto the first variable of the cycle.
+        */
+        const CompiledVariable &last_var = compiled_vars[compiled_cycles[cycle_end - 1]];
+        int last_val = read_packed_value(
+            buffer, last_var.to_var.bin_index, last_var.to_var.shift, last_var.to_var.read_mask);
+        for (int j = cycle_end - 1; j > cycle_start; --j) {
+            const CompiledVariable &var = compiled_vars[compiled_cycles[j]];
+            int from_val = read_packed_value(
+                buffer, var.from_var.bin_index, var.from_var.shift, var.from_var.read_mask);
+            write_packed_value(
+                buffer, var.to_var.bin_index, var.to_var.shift, var.to_var.read_mask,
+                compiled_new_values[var.new_values_offset + from_val]);
+        }
+        const CompiledVariable &first_var = compiled_vars[compiled_cycles[cycle_start]];
+        write_packed_value(
+            buffer, first_var.to_var.bin_index, first_var.to_var.shift, first_var.to_var.read_mask,
+            compiled_new_values[first_var.new_values_offset + last_val]);
+        cycle_start = cycle_end;
+    }
     return true;
 }
@@ -5,6 +5,10 @@
 
 #include "group.h"
 
+#include "../algorithms/int_packer.h"
+
+using PackedStateBin = int_packer::IntPacker::Bin;
+
 /*
   This class represents search symmetries, i.e., it only stores a mapping of
   variables and values, but not of operators of the planning task, since the
@@ -32,10 +36,34 @@ public:
     std::pair<int, int> get_new_var_val_by_old_var_val(const int var, const int val) const;
 
     bool replace_if_less(std::vector<int> &state) const;
+    // Replace the given state by its image under the permutation.
+    void permute(std::vector<int> &state) const;
+    /*
+      Same as above, but operating directly on a packed state buffer. Requires
+      that the permutation has been compiled for the packer of the buffer.
+    */
+    bool replace_if_less(PackedStateBin *buffer) const;
+    void compile_for_packed_states(const int_packer::IntPacker &state_packer);
     const std::vector<int>& get_affected_vars() const { 
         return vars_affected; 
     }
 private:
+    struct PackedVariable {
+        int bin_index;
+        int shift;
+        PackedStateBin read_mask;
+    };
+    /*
+      Compiled form of an affected variable: the bin layout of the variable,
+      the bin layout of the variable mapped onto it and the offset of the
+      value mapping of the latter in compiled_new_values.
+    */
+    struct CompiledVariable {
+        PackedVariable to_var;
+        PackedVariable from_var;
+        int new_values_offset;
+    };
+
     const Group &group;
     std::vector<int> value;
     std::vector<int> vars_affected;
@@ -45,6 +73,18 @@ private:
     // Affected vars by cycles
     std::vector<std::vector<int> > affected_vars_cycles;
 
+    /*
+      Flat tables for packed state buffers: compiled_vars is ordered like
+      vars_affected, compiled_cycles stores the cycles of affected_vars_cycles
+      one after the other (as indices into compiled_vars), each ending before
+      the corresponding entry of compiled_cycle_ends. The value mappings of
+      all variables are stored contiguously in compiled_new_values.
+    */
+    std::vector<CompiledVariable> compiled_vars;
+    std::vector<int> compiled_cycles;
+    std::vector<int> compiled_cycle_ends;
+    std::vector<int> compiled_new_values;
+
     void finalize();
     void _allocate();
     void _copy_value_from_permutation(const Permutation &perm);
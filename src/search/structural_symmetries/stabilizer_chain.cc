@@ -0,0 +1,361 @@
+#include "stabilizer_chain.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <limits>
+#include <set>
+
+using namespace std;
+
+StabilizerChain::StabilizerChain(
+    const Group &group, const vector<RawPermutation> &generators)
+    : group(group),
+      num_vars(group.get_permutation_num_variables()),
+      permutation_length(group.get_permutation_length()) {
+    compute_base(generators);
+    for (const RawPermutation &generator : generators) {
+        add_strong_generator(generator);
+    }
+    schreier_sims();
+    compute_transversal_ids();
+}
+
+RawPermutation StabilizerChain::compose(
+    const RawPermutation &first, const RawPermutation &second) const {
+    RawPermutation result(permutation_length);
+    for (int i = 0; i < permutation_length; ++i) {
+        result[i] = second[first[i]];
+    }
+    return result;
+}
+
+RawPermutation StabilizerChain::invert(const RawPermutation &permutation) const {
+    RawPermutation result(permutation_length);
+    for (int i = 0; i < permutation_length; ++i) {
+        result[permutation[i]] = i;
+    }
+    return result;
+}
+
+bool StabilizerChain::fixes_all_facts(const RawPermutation &permutation) const {
+    for (int i = num_vars; i < permutation_length; ++i) {
+        if (permutation[i] != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void StabilizerChain::compute_base(const vector<RawPermutation> &generators) {
+    vector<int> moved_facts;
+    for (int i = num_vars; i < permutation_length; ++i) {
+        for (const RawPermutation &generator : generators) {
+            if (generator[i] != i) {
+                moved_facts.push_back(i);
+                break;
+            }
+        }
+    }
+    // Order facts by decreasing variable and increasing value.
+    sort(moved_facts.begin(), moved_facts.end(),
+         [this](int lhs, int rhs) {
+             pair<int, int> lhs_var_val = group.get_var_val_by_index(lhs);
+             pair<int, int> rhs_var_val = group.get_var_val_by_index(rhs);
+             if (lhs_var_val.first != rhs_var_val.first) {
+                 return lhs_var_val.first > rhs_var_val.first;
+             }
+             return lhs_var_val.second < rhs_var_val.second;
+         });
+    levels.resize(moved_facts.size());
+    for (size_t i = 0; i < moved_facts.size(); ++i) {
+        Level &level = levels[i];
+        level.base_point = moved_facts[i];
+        pair<int, int> var_val = group.get_var_val_by_index(level.base_point);
+        level.base_var = var_val.first;
+        level.base_val = var_val.second;
+        compute_orbit(level);
+    }
+}
+
+void StabilizerChain::add_strong_generator(const RawPermutation &generator) {
+    assert(!fixes_all_facts(generator));
+    int generator_id = strong_generators.size();
+    strong_generators.push_back(generator);
+    inverse_strong_generators.push_back(invert(generator));
+    // The generator belongs to all levels up to the first moved base point.
+    for (Level &level : levels) {
+        level.generator_ids.push_back(generator_id);
+        compute_orbit(level);
+        if (generator[level.base_point] != level.base_point) {
+            break;
+        }
+    }
+}
+
+void StabilizerChain::compute_orbit(Level &level) const {
+    level.orbit.clear();
+    level.orbit_position.assign(permutation_length, -1);
+    level.to_base_point.clear();
+
+    level.orbit.push_back(level.base_point);
+    level.orbit_position[level.base_point] = 0;
+    RawPermutation identity(permutation_length);
+    iota(identity.begin(), identity.end(), 0);
+    level.to_base_point.push_back(move(identity));
+    for (size_t pos = 0; pos < level.orbit.size(); ++pos) {
+        int point = level.orbit[pos];
+        for (int generator_id : level.generator_ids) {
+            int image = strong_generators[generator_id][point];
+            if (level.orbit_position[image] == -1) {
+                level.orbit_position[image] = level.orbit.size();
+                level.orbit.push_back(image);
+                // image -> point -> base point
+                level.to_base_point.push_back(
+                    compose(inverse_strong_generators[generator_id],
+                            level.to_base_point[pos]));
+            }
+        }
+    }
+}
+
+int StabilizerChain::sift(RawPermutation &permutation, int first_level) const {
+    for (size_t i = first_level; i < levels.size(); ++i) {
+        const Level &level = levels[i];
+        int image = permutation[level.base_point];
+        int pos = level.orbit_position[image];
+        if (pos == -1) {
+            return i;
+        }
+        permutation = compose(permutation, level.to_base_point[pos]);
+    }
+    return levels.size();
+}
+
+void StabilizerChain::schreier_sims() {
+    /*
+      Deterministic Schreier-Sims (see Holt et al., Handbook of
+      Computational Group Theory, Section 4.4.2): starting from the last
+      level, test all Schreier generators of the level. If one of them cannot
+      be sifted through the lower levels, add the residue as a strong
+      generator and continue at the level where sifting failed.
+    */
+    int i = static_cast<int>(levels.size()) - 1;
+    while (i >= 0) {
+        const Level &level = levels[i];
+        int next_level = i - 1;
+        for (size_t pos = 0; pos < level.orbit.size(); ++pos) {
+            RawPermutation from_base_point = invert(level.to_base_point[pos]);
+            bool added_generator = false;
+            for (int generator_id : level.generator_ids) {
+                const RawPermutation &generator = strong_generators[generator_id];
+                int image = generator[level.orbit[pos]];
+                RawPermutation schreier_generator = compose(
+                    compose(from_base_point, generator),
+                    level.to_base_point[level.orbit_position[image]]);
+                int failed_level = sift(schreier_generator, i + 1);
+                if (!fixes_all_facts(schreier_generator)) {
+                    assert(failed_level < static_cast<int>(levels.size()));
+                    add_strong_generator(schreier_generator);
+                    next_level = failed_level;
+                    added_generator = true;
+                    break;
+                }
+            }
+            if (added_generator) {
+                break;
+            }
+        }
+        i = next_level;
+    }
+}
+
+void StabilizerChain::compute_transversal_ids() {
+    int num_elements = 0;
+    for (Level &level : levels) {
+        level.first_transversal_id = num_elements;
+        num_elements += level.orbit.size();
+    }
+}
+
+void StabilizerChain::apply(
+    const RawPermutation &permutation, const vector<int> &state,
+    vector<int> &result) const {
+    result.resize(num_vars);
+    for (int var = 0; var < num_vars; ++var) {
+        int index = group.get_index_by_var_val_pair(var, state[var]);
+        pair<int, int> var_val = group.get_var_val_by_index(permutation[index]);
+        result[var_val.first] = var_val.second;
+    }
+}
+
+/*
+  Compare two states on all facts that come before the fact var=val in the
+  order of the base, i.e., on all variables above var and on var itself if
+  one of the states has a value below val there.
+*/
+static int compare_prefix(
+    const vector<int> &lhs, const vector<int> &rhs, int var, int val) {
+    for (int v = static_cast<int>(lhs.size()) - 1; v > var; --v) {
+        if (lhs[v] != rhs[v]) {
+            return lhs[v] < rhs[v] ? -1 : 1;
+        }
+    }
+    int lhs_val = min(lhs[var], val);
+    int rhs_val = min(rhs[var], val);
+    if (lhs_val != rhs_val) {
+        return lhs_val < rhs_val ? -1 : 1;
+    }
+    return 0;
+}
+
+struct Candidate {
+    vector<int> state;
+    vector<int> trace;
+};
+
+vector<int> StabilizerChain::compute_minimal_image(
+    const vector<int> &state, vector<int> *trace) const {
+    vector<Candidate> candidates(1);
+    candidates[0].state = state;
+
+    vector<Candidate> next_candidates;
+    set<vector<int>> seen_states;
+    for (const Level &level : levels) {
+        if (level.orbit.size() == 1) {
+            continue;
+        }
+
+        /*
+          Only keep candidates that are minimal on all facts before the base
+          point. All facts before the base point are fixed by the stabilizer
+          of this level, so the other candidates cannot lead to the minimum.
+        */
+        size_t num_best = 1;
+        for (size_t i = 1; i < candidates.size(); ++i) {
+            int cmp = compare_prefix(
+                candidates[i].state, candidates[0].state,
+                level.base_var, level.base_val);
+            if (cmp < 0) {
+                swap(candidates[0], candidates[i]);
+                num_best = 1;
+            } else if (cmp == 0) {
+                swap(candidates[num_best++], candidates[i]);
+            }
+        }
+        candidates.resize(num_best);
+
+        /*
+          If some candidate contains a fact of the orbit of the base point,
+          the minimal image contains the base point and we only branch over
+          such facts. Otherwise, every element of the level is the product of
+          a transversal element and an element of the next level, so we
+          branch over the whole transversal.
+        */
+        bool can_contain_base_point = false;
+        for (const Candidate &candidate : candidates) {
+            for (int point : level.orbit) {
+                pair<int, int> var_val = group.get_var_val_by_index(point);
+                if (candidate.state[var_val.first] == var_val.second) {
+                    can_contain_base_point = true;
+                    break;
+                }
+            }
+            if (can_contain_base_point) {
+                break;
+            }
+        }
+
+        next_candidates.clear();
+        seen_states.clear();
+        for (const Candidate &candidate : candidates) {
+            for (size_t pos = 0; pos < level.orbit.size(); ++pos) {
+                if (can_contain_base_point) {
+                    pair<int, int> var_val = group.get_var_val_by_index(level.orbit[pos]);
+                    if (candidate.state[var_val.first] != var_val.second) {
+                        continue;
+                    }
+                }
+                Candidate child;
+                apply(level.to_base_point[pos], candidate.state, child.state);
+                if (!seen_states.insert(child.state).second) {
+                    continue;
+                }
+                if (trace) {
+                    child.trace = candidate.trace;
+                    if (pos != 0) {
+                        child.trace.push_back(level.first_transversal_id + pos);
+                    }
+                }
+                next_candidates.push_back(move(child));
+            }
+        }
+        swap(candidates, next_candidates);
+    }
+
+    size_t best = 0;
+    for (size_t i = 1; i < candidates.size(); ++i) {
+        if (compare_prefix(candidates[i].state, candidates[best].state, 0, numeric_limits<int>::max()) < 0) {
+            best = i;
+        }
+    }
+    if (trace) {
+        *trace = move(candidates[best].trace);
+    }
+    return move(candidates[best].state);
+}
+
+RawPermutation StabilizerChain::compute_permutation_from_trace(
+    const vector<int> &trace) const {
+    RawPermutation permutation(permutation_length);
+    iota(permutation.begin(), permutation.end(), 0);
+    size_t level_index = 0;
+    for (int transversal_id : trace) {
+        // Trace entries are ordered by level.
+        while (level_index + 1 < levels.size() &&
+               levels[level_index + 1].first_transversal_id <= transversal_id) {
+            ++level_index;
+        }
+        const Level &level = levels[level_index];
+        permutation = compose(
+            permutation,
+            level.to_base_point[transversal_id - level.first_transversal_id]);
+    }
+    return permutation;
+}
+
+void StabilizerChain::compute_inverse_transversals() {
+    for (Level &level : levels) {
+        level.from_base_point.clear();
+        level.from_base_point.reserve(level.to_base_point.size());
+        for (const RawPermutation &element : level.to_base_point) {
+            level.from_base_point.push_back(invert(element));
+        }
+    }
+}
+
+void StabilizerChain::apply_inverse_trace(
+    vector<int> &state, const vector<int> &trace) const {
+    vector<int> preimage;
+    int level_index = levels.size() - 1;
+    for (auto it = trace.rbegin(); it != trace.rend(); ++it) {
+        int transversal_id = *it;
+        // Trace entries are ordered by level.
+        while (levels[level_index].first_transversal_id > transversal_id) {
+            --level_index;
+        }
+        const Level &level = levels[level_index];
+        assert(level.from_base_point.size() == level.to_base_point.size());
+        apply(level.from_base_point[transversal_id - level.first_transversal_id],
+              state, preimage);
+        state.swap(preimage);
+    }
+}
+
+int StabilizerChain::get_num_transversal_elements() const {
+    int num_elements = 0;
+    for (const Level &level : levels) {
+        num_elements += level.orbit.size();
+    }
+    return num_elements;
+}
@@ -0,0 +1,98 @@
+#ifndef STRUCTURAL_SYMMETRIES_STABILIZER_CHAIN_H
+#define STRUCTURAL_SYMMETRIES_STABILIZER_CHAIN_H
+
+#include "group.h"
+
+#include <vector>
+
+/*
+  Base and strong generating set of the group generated by the search
+  generators, computed with the deterministic Schreier-Sims algorithm.
+
+  The group acts on the facts of the task (indices of the permutations that
+  are not variable vertices). The base consists of all facts moved by the
+  group, ordered like the lexicographic order on states used for canonical
+  representatives: facts of variables with higher ids come first, and facts
+  of the same variable are ordered by value. Hence, every fact that comes
+  before the i-th base point and is no base point itself is fixed by the
+  stabilizer of the first i-1 base points, which allows computing the
+  lexicographically minimal state of an orbit exactly by processing the
+  levels of the chain one after the other (see compute_minimal_image).
+*/
+class StabilizerChain {
+    struct Level {
+        int base_point;
+        int base_var;
+        int base_val;
+        // Strong generators (indices) fixing all previous base points.
+        std::vector<int> generator_ids;
+        // Orbit of the base point under the strong generators of this level.
+        std::vector<int> orbit;
+        // Position of a fact in orbit or -1; indexed by fact.
+        std::vector<int> orbit_position;
+        // For every orbit point, an element mapping it to the base point.
+        std::vector<RawPermutation> to_base_point;
+        // Inverses of to_base_point, see compute_inverse_transversals.
+        std::vector<RawPermutation> from_base_point;
+        // Id of the transversal element to_base_point[0] (see below).
+        int first_transversal_id;
+    };
+
+    const Group &group;
+    int num_vars;
+    int permutation_length;
+    std::vector<RawPermutation> strong_generators;
+    std::vector<RawPermutation> inverse_strong_generators;
+    std::vector<Level> levels;
+
+    RawPermutation compose(const RawPermutation &first, const RawPermutation &second) const;
+    RawPermutation invert(const RawPermutation &permutation) const;
+    bool fixes_all_facts(const RawPermutation &permutation) const;
+    void add_strong_generator(const RawPermutation &generator);
+    void compute_orbit(Level &level) const;
+    /*
+      Sift the permutation through the levels starting at first_level.
+      Returns the index of the level at which sifting failed (levels.size()
+      if the permutation could be sifted completely) and stores the residue
+      in permutation.
+    */
+    int sift(RawPermutation &permutation, int first_level) const;
+    void compute_base(const std::vector<RawPermutation> &generators);
+    void schreier_sims();
+    void compute_transversal_ids();
+
+    void apply(const RawPermutation &permutation, const std::vector<int> &state,
+               std::vector<int> &result) const;
+public:
+    StabilizerChain(const Group &group, const std::vector<RawPermutation> &generators);
+
+    /*
+      Return the lexicographically minimal state in the orbit of the given
+      (unpacked) state. If trace is given, it is set to the ids of the
+      transversal elements (numbered consecutively over all levels) whose
+      product maps the state to the result.
+    */
+    std::vector<int> compute_minimal_image(
+        const std::vector<int> &state, std::vector<int> *trace = nullptr) const;
+    RawPermutation compute_permutation_from_trace(const std::vector<int> &trace) const;
+    /*
+      Store the inverses of all transversal elements, which doubles the
+      memory of the transversals. Must be called before
+      apply_inverse_trace.
+    */
+    void compute_inverse_transversals();
+    // Replace the given state by its preimage under the product of the trace.
+    void apply_inverse_trace(
+        std::vector<int> &state, const std::vector<int> &trace) const;
+
+    int get_base_length() const {
+        return levels.size();
+    }
+    int get_num_strong_generators() const {
+        return strong_generators.size();
+    }
+    // Sum of the orbit lengths over all levels.
+    int get_num_transversal_elements() const;
+};
+
+#endif
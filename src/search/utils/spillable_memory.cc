@@ -0,0 +1,204 @@
+#include "spillable_memory.h"
+
+#include "logging.h"
+#include "memory.h"
+#include "system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace utils {
+/*
+  Hands out memory from large regions of files in the spill directory.
+  The files are unlinked right after creating them, so they are removed
+  automatically when the planner terminates. Blocks are only used by
+  segmented vectors, which allocate and free segments of a few fixed
+  sizes, so freed blocks are kept in one free list per size.
+*/
+class SpillArena {
+    static const size_t REGION_BYTES = size_t(256) * 1024 * 1024;
+    static const size_t ALIGNMENT = 64;
+
+    struct Region {
+        char *begin;
+        size_t size;
+    };
+
+    const string directory;
+    vector<Region> regions;
+    size_t used_bytes_in_last_region;
+    unordered_map<size_t, vector<void *>> free_blocks;
+    // Segmented vectors of different threads can allocate at the same time.
+    mutex arena_mutex;
+
+    void add_region(size_t min_bytes);
+public:
+    explicit SpillArena(const string &directory);
+
+    void *allocate(size_t num_bytes);
+    bool deallocate(void *ptr, size_t num_bytes);
+};
+
+/*
+  The arena lives until the planner terminates. Its mapped regions are
+  only unmapped by the operating system, since spilled data can be used
+  until the end.
+*/
+static unique_ptr<SpillArena> spill_arena;
+
+static size_t get_aligned_size(size_t num_bytes, size_t alignment) {
+    return (num_bytes + alignment - 1) / alignment * alignment;
+}
+
+SpillArena::SpillArena(const string &directory)
+    : directory(directory),
+      used_bytes_in_last_region(0) {
+}
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+static void exit_with_spill_error(const string &message) {
+    cerr << message << ": " << strerror(errno) << endl;
+    exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+}
+
+/*
+  Mapped files count towards the address space of the process, but the
+  spilled data should not count towards the memory limit. Hence, we raise
+  the soft limit on the address space by the size of every region. This
+  only works if the hard limit is higher, which the driver ensures when
+  it sees the --spill-directory option.
+*/
+static void exempt_from_address_space_limit(size_t num_bytes) {
+    static bool warned = false;
+    rlimit limit;
+    if (getrlimit(RLIMIT_AS, &limit) != 0 || limit.rlim_cur == RLIM_INFINITY) {
+        return;
+    }
+    rlim_t new_limit = limit.rlim_max;
+    if (limit.rlim_max == RLIM_INFINITY ||
+        limit.rlim_max - limit.rlim_cur > num_bytes) {
+        new_limit = limit.rlim_cur + num_bytes;
+    }
+    if (new_limit - limit.rlim_cur < num_bytes && !warned) {
+        g_log << "Warning: the hard address-space limit is too low to exempt "
+              << "spill files from the memory limit." << endl;
+        warned = true;
+    }
+    limit.rlim_cur = new_limit;
+    setrlimit(RLIMIT_AS, &limit);
+}
+
+void SpillArena::add_region(size_t min_bytes) {
+    size_t size = max(REGION_BYTES, get_aligned_size(min_bytes, REGION_BYTES));
+    string path = directory + "/downward-spill-XXXXXX";
+    vector<char> path_buffer(path.begin(), path.end());
+    path_buffer.push_back('\0');
+    int fd = mkstemp(path_buffer.data());
+    if (fd == -1) {
+        exit_with_spill_error("Could not create spill file in " + directory);
+    }
+    unlink(path_buffer.data());
+    if (ftruncate(fd, size) != 0) {
+        exit_with_spill_error("Could not resize spill file");
+    }
+#if OPERATING_SYSTEM == LINUX
+    /*
+      Reserve the disk space now: writing back pages of a sparse file to
+      a full disk would kill the planner with SIGBUS.
+    */
+    int error = posix_fallocate(fd, 0, size);
+    if (error != 0) {
+        errno = error;
+        exit_with_spill_error("Could not reserve disk space for spill file");
+    }
+#endif
+    exempt_from_address_space_limit(size);
+    void *begin = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (begin == MAP_FAILED) {
+        exit_with_spill_error("Could not map spill file");
+    }
+    // The mapping keeps the file alive.
+    close(fd);
+    regions.push_back({static_cast<char *>(begin), size});
+    used_bytes_in_last_region = 0;
+}
+#else
+void SpillArena::add_region(size_t) {
+    cerr << "Spilling state data to disk is not supported on this "
+         << "operating system." << endl;
+    exit_with(ExitCode::SEARCH_UNSUPPORTED);
+}
+#endif
+
+void *SpillArena::allocate(size_t num_bytes) {
+    lock_guard<mutex> lock(arena_mutex);
+    size_t size = get_aligned_size(num_bytes, ALIGNMENT);
+    vector<void *> &blocks = free_blocks[size];
+    if (!blocks.empty()) {
+        void *block = blocks.back();
+        blocks.pop_back();
+        return block;
+    }
+    if (regions.empty() ||
+        used_bytes_in_last_region + size > regions.back().size) {
+        add_region(size);
+    }
+    void *block = regions.back().begin + used_bytes_in_last_region;
+    used_bytes_in_last_region += size;
+    return block;
+}
+
+bool SpillArena::deallocate(void *ptr, size_t num_bytes) {
+    lock_guard<mutex> lock(arena_mutex);
+    char *block = static_cast<char *>(ptr);
+    for (const Region &region : regions) {
+        if (less_equal<char *>()(region.begin, block) &&
+            less<char *>()(block, region.begin + region.size)) {
+            free_blocks[get_aligned_size(num_bytes, ALIGNMENT)].push_back(ptr);
+            return true;
+        }
+    }
+    // The block was allocated on the heap before spilling was enabled.
+    return false;
+}
+
+void set_spill_directory(const string &directory) {
+    assert(!spill_arena);
+    spill_arena = make_unique_ptr<SpillArena>(directory);
+    g_log << "Spilling state data to files in " << directory << endl;
+}
+
+bool is_spilling_enabled() {
+    return spill_arena != nullptr;
+}
+
+void *allocate_spillable(size_t num_bytes) {
+    if (spill_arena) {
+        return spill_arena->allocate(num_bytes);
+    }
+    return ::operator new(num_bytes);
+}
+
+void deallocate_spillable(void *ptr, size_t num_bytes) {
+    if (!spill_arena || !spill_arena->deallocate(ptr, num_bytes)) {
+        ::operator delete(ptr);
+    }
+}
+}
@@ -0,0 +1,56 @@
+#ifndef UTILS_SPILLABLE_MEMORY_H
+#define UTILS_SPILLABLE_MEMORY_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace utils {
+/*
+  Memory for the large data structures that grow with the number of
+  states, such as the state data pool and per-state information.
+
+  If a spill directory is set, this memory is taken from files in that
+  directory that are mapped into memory. The operating system then keeps
+  the recently used pages in RAM and writes the others back to disk when
+  RAM gets scarce, so searches whose data exceeds RAM slow down instead of
+  running out of memory. Otherwise, the memory comes from the heap.
+
+  Mapped files count towards the address space of the process. To keep
+  the spilled data from counting towards a memory limit set with
+  RLIMIT_AS (e.g., by the --search-memory-limit option of the driver),
+  the soft limit is raised by the size of every mapped file. This needs a
+  higher hard limit, which the driver only sets for the search if it is
+  called with --spill-directory.
+*/
+extern void set_spill_directory(const std::string &directory);
+extern bool is_spilling_enabled();
+
+extern void *allocate_spillable(std::size_t num_bytes);
+extern void deallocate_spillable(void *ptr, std::size_t num_bytes);
+
+template<typename T>
+class SpillableAllocator : public std::allocator<T> {
+public:
+    template<typename U>
+    struct rebind {
+        using other = SpillableAllocator<U>;
+    };
+
+    SpillableAllocator() = default;
+
+    template<typename U>
+    SpillableAllocator(const SpillableAllocator<U> &) {
+    }
+
+    T *allocate(std::size_t n) {
+        return static_cast<T *>(allocate_spillable(n * sizeof(T)));
+    }
+
+    void deallocate(T *ptr, std::size_t n) {
+        deallocate_spillable(ptr, n * sizeof(T));
+    }
+};
+}
+
+#endif